@@ -0,0 +1,251 @@
+#ifndef ARA_STAR_H
+#define ARA_STAR_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "board.h"
+#include "neighborhood.h"
+#include "open_list.h"
+
+/* ANYTIME REPAIRING A* (ARA*):
+ * Likhachev, Gordon & Thrun. A weighted A* with f = g + w * h finds a path
+ * that costs at most w times the optimum, and with w > 1 it expands far fewer
+ * nodes than A*. ARA* starts with a large w, reports that path, and then
+ * lowers w step by step. Instead of searching from scratch each time it keeps
+ * all g-values: cells whose g-value got better after they had been expanded
+ * in the current round are parked on an INCONS list and go back onto the open
+ * list for the next round, so every round only repairs what changed.
+ *
+ * Every published solution comes with a suboptimality bound
+ *   bound = min(w, cost / min over OPEN and INCONS of (g + h))
+ * since no path can be cheaper than the smallest g + h still waiting there.
+ * It is 1 once the open and INCONS lists run dry or w reached 1.
+ *
+ * The search stops at w = 1 or when the time budget runs out, whichever comes
+ * first. A round that runs out of time is dropped, the solutions before it
+ * stand. The clock is read every 1024 expansions.
+ *
+ * An AnytimePlanner keeps its per-cell state between queries, stamped with
+ * the round it was written in (like SearchContext): rounds are numbered across
+ * queries, so a new query starts without clearing or allocating anything -
+ * on big boards that alone would eat a tight budget.
+ */
+
+struct AnytimeSolution {
+    std::vector<Point> path;
+    int cost = 0;
+    double weight = 1.0;        // w of the round that found it
+    double bound = 1.0;         // cost <= bound * optimal cost
+    double elapsed_ms = 0;      // since the start of AnytimeSearch()
+    int expansions = 0;         // in total, up to this solution
+};
+
+// f = g + w * h in thousandths, ties go to the lower h
+struct AnytimeKey {
+    std::int64_t f;
+    int h;
+};
+
+inline bool operator<( const AnytimeKey &a, const AnytimeKey &b ) {
+    return a.f < b.f || (a.f == b.f && a.h < b.h);
+}
+
+template <typename Neighborhood = FourConnected>
+class AnytimePlanner {
+  public:
+    /**
+     * Returns one solution per finished round, in order: each one is at least
+     * as cheap as the one before, the last one is the best. Empty if there is
+     * no path, or the budget ran out before the first round finished.
+     */
+    std::vector<AnytimeSolution> Search( const GridView &board, Point init, Point goal,
+                                         double budget_ms, double initial_weight = 3.0,
+                                         double weight_step = 0.5 ) {
+        using Clock = std::chrono::steady_clock;
+        const auto start_time = Clock::now();
+        auto elapsed_ms = [&] {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start_time).count();
+        };
+
+        std::vector<AnytimeSolution> solutions;
+        if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+            board(init.x, init.y) == State::kObstacle) {
+            return solutions;
+        }
+        StartQuery(board.Size());
+
+        const int init_id = board.Index(init.x, init.y);
+        const int goal_id = board.Index(goal.x, goal.y);
+        auto h = [&](int id) {
+            return Neighborhood::Heuristic(board.IndexX(id), board.IndexY(id), goal.x, goal.y);
+        };
+        int weight = std::max(1000, static_cast<int>(std::lround(initial_weight * 1000)));
+        const int step = std::max(1, static_cast<int>(std::lround(weight_step * 1000)));
+        auto key = [&](int id) {
+            const int h_val = h(id);
+            return AnytimeKey{std::int64_t(G(id)) * 1000 + std::int64_t(weight) * h_val, h_val};
+        };
+
+        Set(init_id, 0, -1);
+        open_list_.Push(init_id, key(init_id));
+        int expansions = 0;
+
+        while (true) {
+            // ImprovePath(): run until nothing on the open list can beat the goal
+            const std::uint32_t round = ++round_;
+            bool out_of_time = false;
+            while (!open_list_.Empty()) {
+                if (G(goal_id) != kInfinity &&
+                    !(open_list_.Top().key < AnytimeKey{std::int64_t(G(goal_id)) * 1000, 0})) {
+                    break;
+                }
+                if ((expansions & 1023) == 1023 && elapsed_ms() > budget_ms) {
+                    out_of_time = true;
+                    break;
+                }
+                const int current_id = open_list_.Pop().id;
+                nodes_[current_id].closed = round;
+                expansions++;
+
+                const int current_x = board.IndexX(current_id);
+                const int current_y = board.IndexY(current_id);
+                for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                    const int x = current_x + Neighborhood::kDelta[i][0];
+                    const int y = current_y + Neighborhood::kDelta[i][1];
+                    if (!board.InBounds(x, y) || board(x, y) == State::kObstacle ||
+                        !Neighborhood::CanMove(board, current_x, current_y, i)) {
+                        continue;
+                    }
+                    const int id = board.Index(x, y);
+                    const int g = G(current_id) + Neighborhood::kCost[i];
+                    if (g >= G(id)) {
+                        continue;
+                    }
+                    Set(id, g, current_id);
+                    if (nodes_[id].closed != round) {
+                        open_list_.PushOrDecrease(id, key(id));
+                    } else if (nodes_[id].incons != round) {
+                        nodes_[id].incons = round;
+                        incons_.push_back(id);
+                    }
+                }
+            }
+            if (out_of_time || G(goal_id) == kInfinity) {
+                break;
+            }
+
+            // publish the solution of this round with its bound. cells on the
+            // way may have found cheaper parents since goal got its g-value, so
+            // the path can be cheaper than g(goal) - its cost is added up as we go.
+            AnytimeSolution solution;
+            for (int id = goal_id; id != -1; id = nodes_[id].parent) {
+                solution.path.push_back(Point{board.IndexX(id), board.IndexY(id)});
+            }
+            std::reverse(solution.path.begin(), solution.path.end());
+            int cost = 0;
+            for (std::size_t j = 1; j < solution.path.size(); j++) {
+                const Point from = solution.path[j - 1];
+                const Point to = solution.path[j];
+                for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                    if (from.x + Neighborhood::kDelta[i][0] == to.x &&
+                        from.y + Neighborhood::kDelta[i][1] == to.y) {
+                        cost += Neighborhood::kCost[i];
+                    }
+                }
+            }
+            int lower_bound = kInfinity;
+            for (int i = 0; i < open_list_.Size(); i++) {
+                const int id = open_list_.At(i).id;
+                lower_bound = std::min(lower_bound, G(id) + h(id));
+            }
+            for (int id : incons_) {
+                lower_bound = std::min(lower_bound, G(id) + h(id));
+            }
+            solution.cost = cost;
+            solution.weight = weight / 1000.0;
+            solution.bound = lower_bound == kInfinity || lower_bound >= cost
+                                 ? 1.0
+                                 : std::min(solution.weight, double(cost) / lower_bound);
+            solution.elapsed_ms = elapsed_ms();
+            solution.expansions = expansions;
+            solutions.push_back(std::move(solution));
+            if (solutions.back().bound <= 1.0 || weight == 1000 || elapsed_ms() > budget_ms) {
+                break;
+            }
+
+            // next round: lower w, move INCONS into OPEN and re-key everything
+            weight = std::max(1000, weight - step);
+            open_ids_.clear();
+            for (int i = 0; i < open_list_.Size(); i++) {
+                open_ids_.push_back(open_list_.At(i).id);
+            }
+            open_ids_.insert(open_ids_.end(), incons_.begin(), incons_.end());
+            incons_.clear();
+            open_list_.Clear();
+            for (int id : open_ids_) {
+                open_list_.PushOrDecrease(id, key(id));
+            }
+        }
+        return solutions;
+    }
+
+  private:
+    static constexpr int kInfinity = std::numeric_limits<int>::max();
+
+    struct Node {
+        std::uint32_t seen = 0;     // query that set g and parent
+        std::uint32_t closed = 0;   // round in which the cell was last expanded
+        std::uint32_t incons = 0;   // round in which it went onto INCONS
+        int g = kInfinity;
+        int parent = -1;
+    };
+
+    // forgets the previous query in O(1), like SearchContext::Reset()
+    void StartQuery( int size ) {
+        if (static_cast<int>(nodes_.size()) != size) {
+            nodes_.assign(size, Node{});
+            open_list_.Reset(size);
+            round_ = 0;
+        } else {
+            open_list_.Clear();
+        }
+        incons_.clear();
+        // leave room for the rounds of this query before the stamps wrap
+        if (round_ > std::numeric_limits<std::uint32_t>::max() / 2) {
+            std::fill(nodes_.begin(), nodes_.end(), Node{});
+            round_ = 0;
+        }
+        query_ = ++round_;
+    }
+
+    int G( int id ) const { return nodes_[id].seen == query_ ? nodes_[id].g : kInfinity; }
+
+    void Set( int id, int g, int parent ) {
+        nodes_[id].seen = query_;
+        nodes_[id].g = g;
+        nodes_[id].parent = parent;
+    }
+
+    std::vector<Node> nodes_;
+    IndexedMinHeap<AnytimeKey> open_list_;
+    std::vector<int> incons_;
+    std::vector<int> open_ids_;
+    std::uint32_t round_ = 0;   // rounds are numbered across queries
+    std::uint32_t query_ = 0;   // the round number the current query started at
+};
+
+// one-off AnytimePlanner::Search()
+template <typename Neighborhood = FourConnected>
+std::vector<AnytimeSolution> AnytimeSearch( const GridView &board, Point init, Point goal,
+                                            double budget_ms, double initial_weight = 3.0,
+                                            double weight_step = 0.5 ) {
+    AnytimePlanner<Neighborhood> planner;
+    return planner.Search(board, init, goal, budget_ms, initial_weight, weight_step);
+}
+
+#endif
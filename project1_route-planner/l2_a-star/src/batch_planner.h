@@ -0,0 +1,161 @@
+#ifndef BATCH_PLANNER_H
+#define BATCH_PLANNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "search_context.h"
+
+/* BATCH PLANNER:
+ * Answers many (init, goal) queries on the same board with a fixed pool of
+ * worker threads. The board is only read (FindPath() never writes to it), so
+ * all workers share it, and every worker owns a SearchContext which it reuses
+ * from one query to the next.
+ *
+ * Queries are handed out in small chunks through an atomic counter, so a
+ * worker that drew a few long queries doesn't hold the others up. Each path
+ * is written to its own slot of the result, which keeps the output in query
+ * order without any locking.
+ *
+ * Solve() blocks until the whole batch is done. Calls from several threads
+ * are serialized.
+ */
+
+struct Query {
+    Point init;
+    Point goal;
+};
+
+class BatchPlanner {
+  public:
+    // num_threads = 0 uses one worker per hardware thread
+    explicit BatchPlanner( int num_threads = 0 ) {
+        if (num_threads <= 0) {
+            num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        contexts_.resize(num_threads);
+        for (int i = 0; i < num_threads; i++) {
+            workers_.emplace_back(&BatchPlanner::WorkerLoop, this, i);
+        }
+    }
+
+    BatchPlanner( const BatchPlanner & ) = delete;
+    BatchPlanner &operator=( const BatchPlanner & ) = delete;
+
+    ~BatchPlanner() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_work_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    int Threads() const { return static_cast<int>(workers_.size()); }
+
+    /**
+     * Returns one path per query, in query order (an empty path if there is
+     * none). If results isn't null, it gets the matching SearchResult of every
+     * query as well.
+     */
+    std::vector<std::vector<Point>> Solve( const GridView &board, const std::vector<Query> &queries,
+                                           std::vector<SearchResult> *results = nullptr ) {
+        std::lock_guard<std::mutex> solve_lock(solve_mutex_);
+        std::vector<std::vector<Point>> paths(queries.size());
+        std::vector<SearchResult> summaries(queries.size());
+        if (queries.empty()) {
+            if (results) {
+                results->clear();
+            }
+            return paths;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            board_ = &board;
+            queries_ = &queries;
+            paths_ = &paths;
+            summaries_ = &summaries;
+            next_.store(0, std::memory_order_relaxed);
+            active_ = Threads();
+            batch_++;
+        }
+        cv_work_.notify_all();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_done_.wait(lock, [this] { return active_ == 0; });
+        }
+
+        if (results) {
+            *results = std::move(summaries);
+        }
+        return paths;
+    }
+
+  private:
+    static constexpr int kChunk = 16; // queries taken from the counter at a time
+
+    void WorkerLoop( int index ) {
+        SearchContext &context = contexts_[index];
+        long seen_batch = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_work_.wait(lock, [&] { return stop_ || batch_ != seen_batch; });
+                if (stop_) {
+                    return;
+                }
+                seen_batch = batch_;
+            }
+
+            const int count = static_cast<int>(queries_->size());
+            while (true) {
+                const int begin = next_.fetch_add(kChunk, std::memory_order_relaxed);
+                if (begin >= count) {
+                    break;
+                }
+                const int end = std::min(count, begin + kChunk);
+                for (int i = begin; i < end; i++) {
+                    const Query &query = (*queries_)[i];
+                    FindPath(*board_, query.init, query.goal, context, (*paths_)[i],
+                             &(*summaries_)[i]);
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--active_ == 0) {
+                    cv_done_.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::vector<SearchContext> contexts_;
+
+    std::mutex solve_mutex_; // one batch at a time
+    std::mutex mutex_;       // guards everything below but next_
+    std::condition_variable cv_work_;
+    std::condition_variable cv_done_;
+    bool stop_ = false;
+    long batch_ = 0;
+    int active_ = 0;
+
+    // the batch in progress
+    const GridView *board_ = nullptr;
+    const std::vector<Query> *queries_ = nullptr;
+    std::vector<std::vector<Point>> *paths_ = nullptr;
+    std::vector<SearchResult> *summaries_ = nullptr;
+    std::atomic<int> next_{0};
+};
+
+#endif
@@ -0,0 +1,1166 @@
+// pre-compiler instructions
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ara_star.h"
+#include "batch_planner.h"
+#include "binary_board.h"
+#include "board_generators.h"
+#include "board_io.h"
+#include "cbs.h"
+#include "components.h"
+#include "dstar_lite.h"
+#include "flow_field.h"
+#include "grid_search.h"
+#include "hda_star.h"
+#include "hpa_star.h"
+#include "landmarks.h"
+#include "multi_goal.h"
+#include "path_format.h"
+#include "route_planner.h"
+#include "terrain.h"
+#include "tiled_board.h"
+
+/* to build and run:
+ * $ cd obj/
+ * $ g++ -O2 -pthread ../src/benchmark.cpp -o ./benchmark.o && ./benchmark.o
+ * run a single section with e.g. $ ./benchmark.o loader
+ */
+
+using CLOCK = std::chrono::high_resolution_clock;
+
+// every operator new of the program, for the allocations section
+std::atomic<long long> allocation_count{0};
+
+void *operator new( std::size_t size ) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// not inlined: g++ would see free() on memory from new and warn
+__attribute__((noinline)) void operator delete( void *pointer ) noexcept { std::free(pointer); }
+__attribute__((noinline)) void operator delete( void *pointer, std::size_t ) noexcept {
+    std::free(pointer);
+}
+
+// runs search(board, init, goal) `reps` times and returns the mean time in ms
+template <typename SearchFcn>
+double TimeSearch( SearchFcn search, const vector<vector<State>> &board, int reps ) {
+    int init[2]{0, 0};
+    int goal[2]{static_cast<int>(board.size()) - 1, static_cast<int>(board[0].size()) - 1};
+
+    std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+    auto t1 = CLOCK::now();
+    for (int i = 0; i < reps; i++) {
+        auto solution = search(board, init, goal);
+    }
+    auto t2 = CLOCK::now();
+    std::cout.clear();
+
+    return std::chrono::duration<double, std::milli>(t2 - t1).count() / reps;
+}
+
+// Search() vs. the original CellSort() loop
+void BenchmarkOpenList() {
+    const double density = 0.15;
+    const int reps = 3;
+
+    // NOTE: the CellSort path is O(n^2 log n), a single 256x256 search
+    // already takes several seconds, so we stop at 128x128.
+    cout << "size      CellSort [ms]   OpenList [ms]   speedup" << "\n";
+    for (int size : {32, 64, 128}) {
+        auto board = RandomBoard(size, density, 42).ToNested();
+        vector<SearchNode> open_nodes;
+        double t_sort = TimeSearch(
+            [&open_nodes](const vector<vector<State>> &b, int *init, int *goal) {
+                return SearchCellSort(b, init, goal, open_nodes);
+            }, board, reps);
+        double t_heap = TimeSearch(
+            [](const vector<vector<State>> &b, int *init, int *goal) {
+                return Search(b, init, goal);
+            }, board, reps);
+        cout << size << "x" << size << "\t  "
+             << t_sort << "\t  "
+             << t_heap << "\t  "
+             << t_sort / t_heap << std::endl;
+    }
+}
+
+// rows/sec of the board file loaders on generated boards
+void BenchmarkLoaders() {
+    const std::string path = "/tmp/benchmark.board";
+
+    cout << "size        file [MB]   loader          time [ms]   rows/sec" << "\n";
+    for (int size : {1024, 4096}) {
+        WriteBoardFile(RandomBoard(size, 0.2, 7), path);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        const double megabytes = file.tellg() / 1e6;
+
+        auto report = [&](const char *name, double ms) {
+            cout << size << "x" << size << "\t" << megabytes << "\t    "
+                 << name << "\t" << ms << "\t" << size / (ms / 1000) << std::endl;
+        };
+
+        auto t1 = CLOCK::now();
+        auto nested = ReadBoardFile(path);
+        auto t2 = CLOCK::now();
+        Grid grid = ReadGridFile(path);
+        auto t3 = CLOCK::now();
+        Grid mapped = LoadBoardMmap(path);
+        auto t4 = CLOCK::now();
+
+        report("ReadBoardFile", std::chrono::duration<double, std::milli>(t2 - t1).count());
+        report("ReadGridFile ", std::chrono::duration<double, std::milli>(t3 - t2).count());
+        report("LoadBoardMmap", std::chrono::duration<double, std::milli>(t4 - t3).count());
+        if (mapped != grid || Grid(nested) != grid) {
+            cout << "loaders disagree!" << "\n";
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// startup time of the binary board format vs. parsing the text file
+void BenchmarkBinaryBoard() {
+    const std::string path = "/tmp/benchmark.board";
+    const std::string binary_path = "/tmp/benchmark.bin";
+
+    cout << "size        encoding   file [MB]   open [ms]   ToGrid [ms]   LoadBoardMmap [ms]" << "\n";
+    for (int size : {1024, 4096}) {
+        Grid grid = RandomBoard(size, 0.2, 7);
+        WriteBoardFile(grid, path);
+        auto t0 = CLOCK::now();
+        LoadBoardMmap(path);
+        const double t_text = std::chrono::duration<double, std::milli>(CLOCK::now() - t0).count();
+
+        for (BoardEncoding encoding : {BoardEncoding::kState8, BoardEncoding::kBit1}) {
+            ConvertBoardFile(path, binary_path, encoding);
+
+            auto t1 = CLOCK::now();
+            MappedBoard board(binary_path);
+            auto t2 = CLOCK::now();
+            Grid loaded = board.ToGrid();
+            auto t3 = CLOCK::now();
+
+            cout << size << "x" << size << "\t"
+                 << (encoding == BoardEncoding::kState8 ? "state8" : "bit1  ") << "\t   "
+                 << (board.Header().payload_offset + board.Header().payload_size) / 1e6 << "\t"
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() << "\t"
+                 << std::chrono::duration<double, std::milli>(t3 - t2).count() << "\t\t"
+                 << t_text << std::endl;
+            if (loaded != grid) {
+                cout << "binary board does not match!" << "\n";
+            }
+        }
+    }
+    std::remove(path.c_str());
+    std::remove(binary_path.c_str());
+}
+
+// Search() with and without the passability bitmap
+void BenchmarkBitmap() {
+    const int reps = 5;
+
+    cout << "size        grid [MB]   bitmap [MB]   Search [ms]   Search+bitmap [ms]" << "\n";
+    for (int size : {256, 1024, 2048}) {
+        Grid grid = RandomBoard(size, 0.15, 3);
+        PassabilityBitmap free_cells(grid);
+        int init[2]{0, 0};
+        int goal[2]{size - 1, size - 1};
+
+        std::cout.setstate(std::ios_base::failbit);
+        auto t1 = CLOCK::now();
+        for (int i = 0; i < reps; i++) {
+            Search(grid, init, goal);
+        }
+        auto t2 = CLOCK::now();
+        for (int i = 0; i < reps; i++) {
+            Search(grid, free_cells, init, goal);
+        }
+        auto t3 = CLOCK::now();
+        std::cout.clear();
+
+        cout << size << "x" << size << "\t" << grid.Size() / 1e6 << "\t    "
+             << free_cells.Bytes() / 1e6 << "\t  "
+             << std::chrono::duration<double, std::milli>(t2 - t1).count() / reps << "\t\t"
+             << std::chrono::duration<double, std::milli>(t3 - t2).count() / reps << std::endl;
+    }
+}
+
+// expansions and wall time of A* vs. Jump Point Search
+void BenchmarkJumpPoint() {
+    const int size = 1024;
+    struct Board {
+        const char *name;
+        Grid grid;
+    };
+    const Board boards[]{{"open     ", OpenBoard(size)},
+                         {"maze     ", MazeBoard(size, 11)},
+                         {"cluttered", RandomBoard(size, 0.3, 5)}};
+
+    cout << "board (" << size << "x" << size << ")  mode   cost    expansions   time [ms]" << "\n";
+    for (const Board &board : boards) {
+        int init[2]{0, 0};
+        int goal[2]{size - 1, size - 1};
+        // the bitmap is built once per board, like the board itself
+        auto t0 = CLOCK::now();
+        PassabilityBitmap free_cells(board.grid);
+        const double t_bitmap = std::chrono::duration<double, std::milli>(CLOCK::now() - t0).count();
+
+        SearchContext context;
+        for (SearchMode mode : {SearchMode::kAStar, SearchMode::kJumpPoint}) {
+            SearchResult result;
+            std::cout.setstate(std::ios_base::failbit);
+            auto t1 = CLOCK::now();
+            if (mode == SearchMode::kAStar) {
+                Search(board.grid, init, goal, context, &result);
+            } else {
+                JumpPointSearch(board.grid.View(), free_cells, init, goal, context, &result);
+            }
+            auto t2 = CLOCK::now();
+            std::cout.clear();
+            cout << board.name << "\t    " << (mode == SearchMode::kAStar ? "A*     " : "JPS    ")
+                 << result.cost << "\t" << result.expansions << "\t     "
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() << std::endl;
+        }
+        cout << "  (bitmap built in " << t_bitmap << " ms)" << "\n";
+    }
+}
+
+// expansions and latency of one-directional vs. bidirectional A*
+void BenchmarkBidirectional() {
+    const int size = 1024;
+    const int queries = 20;
+    struct Board {
+        const char *name;
+        Grid grid;
+    };
+    const Board boards[]{{"open     ", OpenBoard(size)},
+                         {"maze     ", MazeBoard(size, 11)},
+                         {"cluttered", RandomBoard(size, 0.3, 5)}};
+
+    cout << "board (" << size << "x" << size << ")  mode            expansions/query   ms/query" << "\n";
+    for (const Board &board : boards) {
+        // long point-to-point queries between random free cells
+        std::mt19937 rng(17);
+        vector<vector<int>> pairs;
+        while (static_cast<int>(pairs.size()) < queries) {
+            vector<int> q{int(rng() % size), int(rng() % size), int(rng() % size), int(rng() % size)};
+            if (board.grid(q[0], q[1]) != State::kObstacle && board.grid(q[2], q[3]) != State::kObstacle &&
+                Heuristic(q[0], q[1], q[2], q[3]) > size / 2) {
+                pairs.push_back(q);
+            }
+        }
+        SearchContext context;
+        BidirectionalContext sides;
+        for (SearchMode mode : {SearchMode::kAStar, SearchMode::kBidirectional}) {
+            long expansions = 0;
+            auto t1 = CLOCK::now();
+            for (auto &q : pairs) {
+                const Point init{q[0], q[1]};
+                const Point goal{q[2], q[3]};
+                SearchResult result;
+                if (mode == SearchMode::kAStar) {
+                    SearchBoard(board.grid.View(), init, goal, context, &result);
+                } else {
+                    BidirectionalSearch(board.grid.View(), init, goal, sides, &result);
+                }
+                expansions += result.expansions;
+            }
+            auto t2 = CLOCK::now();
+            cout << board.name << "\t    " << (mode == SearchMode::kAStar ? "A*           " : "bidirectional")
+                 << "\t" << expansions / queries << "\t\t"
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries << std::endl;
+        }
+    }
+}
+
+// HPA* precomputation, warm start and queries vs. plain A*
+void BenchmarkHierarchical() {
+    const int size = 2048;
+    const int queries = 100;
+    const std::string path = "/tmp/benchmark.hpa";
+    Grid grid = RandomBoard(size, 0.2, 9);
+
+    auto t1 = CLOCK::now();
+    HierarchicalMap map;
+    map.Build(grid.View(), 16);
+    auto t2 = CLOCK::now();
+    map.Save(path);
+    auto t3 = CLOCK::now();
+    HierarchicalMap warm;
+    warm.Load(path);
+    auto t4 = CLOCK::now();
+    cout << "HPA* on " << size << "x" << size << ": " << map.NodeCount() << " nodes, "
+         << map.EdgeCount() << " edges" << "\n";
+    cout << "build " << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms, "
+         << "save " << std::chrono::duration<double, std::milli>(t3 - t2).count() << " ms, "
+         << "load " << std::chrono::duration<double, std::milli>(t4 - t3).count() << " ms" << "\n";
+
+    std::mt19937 rng(23);
+    double t_astar = 0;
+    double t_hpa = 0;
+    double suboptimality = 0;
+    int solved = 0;
+    for (int i = 0; i < queries; i++) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) == State::kObstacle || grid(b.x, b.y) == State::kObstacle) {
+            continue;
+        }
+        int init[2]{a.x, a.y};
+        int goal[2]{b.x, b.y};
+        SearchResult optimal;
+        SearchResult approximate;
+        std::cout.setstate(std::ios_base::failbit);
+        auto q1 = CLOCK::now();
+        Search(grid, init, goal, &optimal);
+        auto q2 = CLOCK::now();
+        warm.FindPath(grid.View(), a, b, &approximate);
+        auto q3 = CLOCK::now();
+        std::cout.clear();
+        t_astar += std::chrono::duration<double, std::milli>(q2 - q1).count();
+        t_hpa += std::chrono::duration<double, std::milli>(q3 - q2).count();
+        if (optimal.found && optimal.cost > 0) {
+            suboptimality += double(approximate.cost) / optimal.cost;
+            solved++;
+        }
+    }
+    cout << "A* " << t_astar / queries << " ms/query, HPA* " << t_hpa / queries
+         << " ms/query, HPA* path length " << suboptimality / solved << " x optimal" << std::endl;
+    std::remove(path.c_str());
+}
+
+// back-to-back queries: Search() copying the board in and out vs. FindPath()
+// on the shared board with one reused SearchContext
+void BenchmarkSearchContext() {
+    cout << "size\tqueries\tSearch() ms/query\tFindPath() ms/query" << "\n";
+    for (int size : {64, 256, 1024}) {
+        const int queries = 1000;
+        Grid grid = RandomBoard(size, 0.2, 12);
+        std::mt19937 rng(5);
+        vector<Query> batch;
+        while (static_cast<int>(batch.size()) < queries) {
+            Point a{int(rng() % size), int(rng() % size)};
+            Point b{int(rng() % size), int(rng() % size)};
+            if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+                batch.push_back(Query{a, b});
+            }
+        }
+
+        std::cout.setstate(std::ios_base::failbit);
+        auto t1 = CLOCK::now();
+        for (const Query &query : batch) {
+            int init[2]{query.init.x, query.init.y};
+            int goal[2]{query.goal.x, query.goal.y};
+            Search(grid, init, goal);
+        }
+        auto t2 = CLOCK::now();
+        SearchContext context;
+        vector<Point> path;
+        for (const Query &query : batch) {
+            FindPath(grid.View(), query.init, query.goal, context, path);
+        }
+        auto t3 = CLOCK::now();
+        std::cout.clear();
+        cout << size << "\t" << queries << "\t"
+             << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries << "\t\t\t"
+             << std::chrono::duration<double, std::milli>(t3 - t2).count() / queries << std::endl;
+    }
+}
+
+// size of a search result: the whole board vs. the route in each path format
+void BenchmarkPathFormat() {
+    const int size = 1024;
+    cout << "board\t\tboard [B]\tcells [B]\twaypoints [B]\tmoves [B]" << "\n";
+    for (int maze = 0; maze < 2; maze++) {
+        Grid grid = maze ? MazeBoard(size, 3) : RandomBoard(size, 0.2, 3);
+        SearchContext context;
+        vector<Point> route = FindPath(grid.View(), Point{0, 0}, Point{size - 1, size - 1}, context);
+        cout << (maze ? "maze" : "random") << " " << size << "\t" << grid.Size() * sizeof(State) << "\t\t"
+             << route.size() * sizeof(Point) << "\t\t" << Waypoints(route).size() * sizeof(Point)
+             << "\t\t" << EncodeMoves(route).size() << std::endl;
+    }
+}
+
+// 8-connected moves with the 4-connected (Manhattan) estimate, for comparison only:
+// it overestimates diagonals, so its paths aren't optimal
+struct EightConnectedManhattan : EightConnected {
+    static int Heuristic( int x1, int y1, int x2, int y2 ) {
+        return kStraight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+    }
+};
+
+template <typename Neighborhood>
+void TimeNeighborhood( const char *name, const Grid &grid, const vector<Query> &queries ) {
+    SearchContext context;
+    vector<Point> path;
+    long expansions = 0;
+    long cost = 0;
+    auto t1 = CLOCK::now();
+    for (const Query &query : queries) {
+        SearchResult result;
+        FindPath<Neighborhood>(grid.View(), query.init, query.goal, context, path, &result);
+        expansions += result.expansions;
+        cost += result.cost;
+    }
+    auto t2 = CLOCK::now();
+    const int n = queries.size();
+    cout << name << "\t" << expansions / n << "\t\t" << double(cost) / n << "\t\t"
+         << std::chrono::duration<double, std::milli>(t2 - t1).count() / n << std::endl;
+}
+
+// the neighborhood policies on the same queries
+void BenchmarkNeighborhood() {
+    const int size = 1024;
+    const int queries = 100;
+    Grid grid = RandomBoard(size, 0.2, 8);
+    std::mt19937 rng(17);
+    vector<Query> batch;
+    while (static_cast<int>(batch.size()) < queries) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            batch.push_back(Query{a, b});
+        }
+    }
+    cout << queries << " queries on " << size << "x" << size << " (8-connected costs in tenths)" << "\n";
+    cout << "policy\t\t\texpansions\tmean cost\tms/query" << "\n";
+    TimeNeighborhood<FourConnected>("4-connected\t\t", grid, batch);
+    TimeNeighborhood<EightConnected>("8-connected\t\t", grid, batch);
+    TimeNeighborhood<EightConnectedNoCornerCutting>("8, no corner cutting\t", grid, batch);
+    TimeNeighborhood<EightConnectedManhattan>("8 w/ Manhattan\t\t", grid, batch);
+}
+
+// per-cell costs vs. the plain board, on the same queries
+void BenchmarkTerrain() {
+    const int size = 1024;
+    const int queries = 100;
+    Grid grid = RandomBoard(size, 0.2, 6);
+    Terrain uniform(grid.View());
+    Terrain weighted(grid.View());
+    std::mt19937 rng(13);
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            if (weighted.Cost(x, y) != Terrain::kBlocked) {
+                weighted.SetCost(x, y, 1 + rng() % 9);
+            }
+        }
+    }
+    vector<Query> batch;
+    while (static_cast<int>(batch.size()) < queries) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            batch.push_back(Query{a, b});
+        }
+    }
+
+    cout << queries << " queries on " << size << "x" << size << "\n";
+    cout << "board\t\t\texpansions\tms/query" << "\n";
+    for (int board = 0; board < 3; board++) {
+        SearchContext context;
+        WideSearchContext wide_context;     // Terrain searches keep 64-bit costs
+        vector<Point> path;
+        long expansions = 0;
+        auto t1 = CLOCK::now();
+        for (const Query &query : batch) {
+            SearchResult result;
+            if (board == 0) {
+                FindPath(grid.View(), query.init, query.goal, context, path, &result);
+            } else {
+                FindPath(board == 1 ? uniform : weighted, query.init, query.goal, wide_context, path,
+                         &result);
+            }
+            expansions += result.expansions;
+        }
+        auto t2 = CLOCK::now();
+        const char *names[3]{"plain board\t\t", "terrain, all cost 1\t", "terrain, costs 1..9\t"};
+        cout << names[board] << expansions / queries << "\t\t"
+             << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries << std::endl;
+    }
+}
+
+// D* Lite repairs vs. replanning from scratch after every batch of changes
+void BenchmarkDStarLite() {
+    const int size = 1024;
+    const int updates = 50;
+    Grid grid = RandomBoard(size, 0.2, 22);
+    const Point start{0, 0};
+    const Point goal{size - 1, size - 1};
+    std::mt19937 rng(2);
+
+    DStarLite<> planner;
+    SearchResult initial;
+    auto t1 = CLOCK::now();
+    planner.Plan(grid.View(), start, goal, &initial);
+    auto t2 = CLOCK::now();
+    cout << "D* Lite on " << size << "x" << size << ": initial plan "
+         << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms, "
+         << initial.expansions << " expansions" << "\n";
+
+    // every batch blocks one cell on the current path and flips 4 random cells
+    double t_repair = 0;
+    double t_replan = 0;
+    long repair_expansions = 0;
+    long replan_expansions = 0;
+    SearchContext context;
+    vector<Point> path;
+    for (int i = 0; i < updates; i++) {
+        vector<Point> route = planner.Path();
+        if (route.size() < 3) {
+            break;
+        }
+        vector<CellChange> batch{{route[1 + rng() % (route.size() - 2)], State::kObstacle}};
+        for (int k = 0; k < 4; k++) {
+            Point cell{int(rng() % size), int(rng() % size)};
+            if (cell != start && cell != goal) {
+                batch.push_back(CellChange{cell, rng() % 2 ? State::kObstacle : State::kEmpty});
+            }
+        }
+        SearchResult repair;
+        SearchResult replan;
+        auto q1 = CLOCK::now();
+        planner.UpdateCells(batch, &repair);
+        auto q2 = CLOCK::now();
+        FindPath(planner.Board().View(), start, goal, context, path, &replan);
+        auto q3 = CLOCK::now();
+        t_repair += std::chrono::duration<double, std::milli>(q2 - q1).count();
+        t_replan += std::chrono::duration<double, std::milli>(q3 - q2).count();
+        repair_expansions += repair.expansions;
+        replan_expansions += replan.expansions;
+    }
+    cout << "per batch of 5 changes\texpansions\tms" << "\n";
+    cout << "D* Lite repair\t\t" << repair_expansions / updates << "\t\t" << t_repair / updates << "\n";
+    cout << "A* from scratch\t\t" << replan_expansions / updates << "\t\t" << t_replan / updates
+         << std::endl;
+}
+
+// ARA* solutions over time vs. a single optimal A* search
+void BenchmarkAnytime() {
+    const int size = 2048;
+    Grid grid = RandomBoard(size, 0.3, 5);
+    const Point init{0, 0};
+    const Point goal{size - 1, size - 1};
+
+    SearchContext context;
+    SearchResult optimal;
+    auto t1 = CLOCK::now();
+    FindPath(grid.View(), init, goal, context, &optimal);
+    auto t2 = CLOCK::now();
+    cout << "A* on " << size << "x" << size << ": cost " << optimal.cost << ", "
+         << optimal.expansions << " expansions, "
+         << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms" << "\n";
+
+    AnytimePlanner<> planner;
+    planner.Search(grid.View(), init, goal, 0.0); // warm-up: allocates the per-cell state
+    cout << "budget [ms]\tw\tcost\tbound\ttrue ratio\tat [ms]" << "\n";
+    for (double budget : {5.0, 20.0, 1000.0}) {
+        vector<AnytimeSolution> solutions = planner.Search(grid.View(), init, goal, budget, 3.0, 0.5);
+        for (const AnytimeSolution &solution : solutions) {
+            cout << budget << "\t\t" << solution.weight << "\t" << solution.cost << "\t"
+                 << solution.bound << "\t" << double(solution.cost) / optimal.cost << "\t\t"
+                 << solution.elapsed_ms << "\n";
+        }
+        if (solutions.empty()) {
+            cout << budget << "\t\tno solution in time" << "\n";
+        }
+    }
+    cout << std::flush;
+}
+
+// plain A* vs. the ALT estimate with 4..16 landmarks, on a board of long walls
+// (every 64th row, alternating gaps at the ends) and on a maze
+void BenchmarkLandmarks() {
+    const int size = 1024;
+    Grid walls = RandomBoard(size, 0.1, 6);
+    for (int x = 32; x < size; x += 64) {
+        const int gap = (x / 64) % 2 == 0 ? size - 1 : 0;
+        for (int y = 0; y < size; y++) {
+            walls(x, y) = State::kObstacle;
+        }
+        // keep the gap reachable from both sides
+        walls(x - 1, gap) = walls(x, gap) = walls(x + 1, gap) = State::kEmpty;
+    }
+    const std::pair<const char *, Grid> boards[]{{"walls", walls},
+                                                 {"maze", MazeBoard(size - 1, 6)}};
+    const std::string path = "/tmp/benchmark_landmarks.alt";
+
+    for (const auto &[name, grid] : boards) {
+        std::mt19937 rng(16);
+        vector<Query> queries;
+        while (queries.size() < 100) {
+            Point a{int(rng() % grid.Rows()), int(rng() % grid.Cols())};
+            Point b{int(rng() % grid.Rows()), int(rng() % grid.Cols())};
+            if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+                queries.push_back(Query{a, b});
+            }
+        }
+        cout << name << " " << grid.Rows() << "x" << grid.Cols() << ", " << queries.size()
+             << " queries" << "\n";
+        cout << "estimate\tbuild [ms]\topen [ms]\tfile [MB]\texpansions/query\tms/query"
+             << "\n";
+
+        SearchContext context;
+        vector<Point> route;
+        auto run = [&](auto find_path) {
+            long long expansions = 0;
+            auto t1 = CLOCK::now();
+            for (const Query &query : queries) {
+                SearchResult result;
+                find_path(query, &result);
+                expansions += result.expansions;
+            }
+            auto t2 = CLOCK::now();
+            cout << expansions / queries.size() << "\t\t\t"
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries.size()
+                 << std::endl;
+        };
+        cout << "Manhattan\t-\t\t-\t\t-\t\t";
+        run([&](const Query &query, SearchResult *result) {
+            FindPath(grid.View(), query.init, query.goal, context, route, result);
+        });
+        for (int count : {4, 8, 16}) {
+            Landmarks<> built;
+            auto t1 = CLOCK::now();
+            built.Build(grid.View(), count);
+            auto t2 = CLOCK::now();
+            built.Save(path);
+            Landmarks<> landmarks;
+            auto t3 = CLOCK::now();
+            landmarks.Open(path);
+            auto t4 = CLOCK::now();
+            cout << "ALT " << count << "\t\t"
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() << "\t\t"
+                 << std::chrono::duration<double, std::milli>(t4 - t3).count() << "\t\t"
+                 << grid.Size() * count * 4.0 / (1 << 20) << "\t\t";
+            run([&](const Query &query, SearchResult *result) {
+                landmarks.FindPath(grid.View(), query.init, query.goal, context, route, result);
+            });
+        }
+        std::remove(path.c_str());
+    }
+}
+
+// random queries on a board near the percolation threshold, where many goals
+// are unreachable: A* alone vs. asking the ComponentIndex first, plus the cost
+// of keeping the index up to date while cells flip
+void BenchmarkComponents() {
+    const int size = 1024;
+    Grid grid = RandomBoard(size, 0.38, 17);
+    std::mt19937 rng(17);
+    vector<Query> queries;
+    while (queries.size() < 200) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            queries.push_back(Query{a, b});
+        }
+    }
+
+    auto t1 = CLOCK::now();
+    ComponentIndex<> components(grid.View());
+    auto t2 = CLOCK::now();
+    int unreachable = 0;
+    for (const Query &query : queries) {
+        unreachable += !components.Connected(query.init, query.goal);
+    }
+    cout << size << "x" << size << ": " << components.Count() << " components, built in "
+         << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms, "
+         << unreachable << " of " << queries.size() << " queries unreachable" << "\n";
+
+    SearchContext context;
+    vector<Point> path;
+    cout << "\t\treachable [ms]\tunreachable [ms]" << "\n";
+    for (bool indexed : {false, true}) {
+        double times[2]{0, 0};
+        for (const Query &query : queries) {
+            auto t3 = CLOCK::now();
+            const bool found = indexed
+                ? FindPath(grid.View(), components, query.init, query.goal, context, path)
+                : FindPath(grid.View(), query.init, query.goal, context, path);
+            auto t4 = CLOCK::now();
+            times[found] += std::chrono::duration<double, std::milli>(t4 - t3).count();
+        }
+        cout << (indexed ? "index + A*" : "A*") << "\t" << times[1] << "\t\t" << times[0]
+             << std::endl;
+    }
+
+    const int flips = 10000;
+    auto t5 = CLOCK::now();
+    for (int i = 0; i < flips; i++) {
+        const int x = rng() % size;
+        const int y = rng() % size;
+        grid(x, y) = grid(x, y) == State::kObstacle ? State::kEmpty : State::kObstacle;
+        components.Update(grid.View(), Point{x, y});
+    }
+    auto t6 = CLOCK::now();
+    cout << flips << " cell flips: "
+         << std::chrono::duration<double, std::micro>(t6 - t5).count() / flips
+         << " us per Update(), " << components.Count() << " components" << std::endl;
+}
+
+// one long query with HDA* on 1..N threads vs. plain A*
+void BenchmarkHda() {
+    const int size = 2048;
+    Grid grid = RandomBoard(size, 0.3, 5);
+    const Point init{0, 0};
+    const Point goal{size - 1, size - 1};
+
+    SearchContext context;
+    vector<Point> path;
+    SearchResult reference;
+    auto t1 = CLOCK::now();
+    FindPath(grid.View(), init, goal, context, path, &reference);
+    auto t2 = CLOCK::now();
+    const double base = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    cout << "A* on " << size << "x" << size << ": cost " << reference.cost << ", "
+         << reference.expansions << " expansions, " << base << " ms ("
+         << std::thread::hardware_concurrency() << " hardware threads)" << "\n";
+    cout << "threads\tcost\texpansions\tms\tspeedup" << "\n";
+    const int max_threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        HdaStar<> search(threads);
+        SearchResult result;
+        auto t3 = CLOCK::now();
+        search.FindPath(grid.View(), init, goal, path, &result);
+        auto t4 = CLOCK::now();
+        const double ms = std::chrono::duration<double, std::milli>(t4 - t3).count();
+        cout << threads << "\t" << result.cost << "\t" << result.expansions << "\t\t" << ms
+             << "\t" << base / ms << std::endl;
+    }
+}
+
+// the same queries on the board in memory and paged in from a tiled file
+// through LRU caches of different sizes; the tiled searches keep state only
+// for the tiles they reach
+void BenchmarkTiledBoard() {
+    const int size = 4096;
+    const int tile_size = 128;
+    Grid grid = RandomBoard(size, 0.2, 19);
+    const std::string path = "/tmp/benchmark_tiled.tiles";
+    WriteTiledBoard(grid.View(), path, tile_size);
+    std::mt19937 rng(19);
+    vector<Query> queries;
+    while (queries.size() < 20) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(a.x + rng() % 1024) % size, int(a.y + rng() % 1024) % size};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            queries.push_back(Query{a, b});
+        }
+    }
+
+    SearchContext context;
+    vector<Point> route;
+    std::size_t dense_bytes = 0;
+    auto t1 = CLOCK::now();
+    for (const Query &query : queries) {
+        FindPath(grid.View(), query.init, query.goal, context, route);
+        dense_bytes = std::max(dense_bytes, context.Stats().peak_memory);
+    }
+    auto t2 = CLOCK::now();
+    cout << size << "x" << size << ", " << tile_size << "x" << tile_size << " tiles, "
+         << queries.size() << " queries" << "\n";
+    cout << "board\t\tresident [MB]\tsearch state [MB]\tms/query\thit rate\tmisses/query" << "\n";
+    cout << "in memory\t" << grid.Size() / double(1 << 20) << "\t\t" << dense_bytes / double(1 << 20)
+         << "\t\t\t" << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries.size()
+         << std::endl;
+    TiledSearch<> search;
+    for (int cache_tiles : {16, 64, 256}) {
+        TiledBoard board(path, cache_tiles);
+        std::size_t sparse_bytes = 0;
+        auto t3 = CLOCK::now();
+        for (const Query &query : queries) {
+            search.FindPath(board, query.init, query.goal, route);
+            sparse_bytes = std::max(sparse_bytes, search.MemoryBytes());
+        }
+        auto t4 = CLOCK::now();
+        const double lookups = board.Hits() + board.Misses();
+        cout << cache_tiles << " tiles\t" << cache_tiles * tile_size * tile_size / double(1 << 20)
+             << "\t\t" << sparse_bytes / double(1 << 20) << "\t\t\t"
+             << std::chrono::duration<double, std::milli>(t4 - t3).count() / queries.size()
+             << "\t\t" << board.Hits() / lookups << "\t" << board.Misses() / queries.size()
+             << std::endl;
+    }
+    std::remove(path.c_str());
+}
+
+// "the closest of these goals": one FindPath() per goal vs. one
+// FindNearestPath() that scans the goals (up to 16) or uses their bounding box
+void BenchmarkNearestGoal() {
+    const int size = 1024;
+    const int queries = 10;
+    Grid grid = RandomBoard(size, 0.2, 23);
+    std::mt19937 rng(23);
+    auto random_free_cell = [&]() {
+        while (true) {
+            Point cell{int(rng() % size), int(rng() % size)};
+            if (grid(cell.x, cell.y) != State::kObstacle) {
+                return cell;
+            }
+        }
+    };
+
+    SearchContext context;
+    vector<Point> route;
+    cout << size << "x" << size << ", " << queries << " queries" << "\n";
+    cout << "goals\tone per goal [ms]\tnearest [ms]\tspeedup\texpansions (per goal / nearest)" << "\n";
+    for (int count : {4, 16, 64, 200}) {
+        double t_each = 0;
+        double t_nearest = 0;
+        long long expansions_each = 0;
+        long long expansions_nearest = 0;
+        for (int q = 0; q < queries; q++) {
+            const Point init = random_free_cell();
+            vector<Point> goals;
+            for (int i = 0; i < count; i++) {
+                goals.push_back(random_free_cell());
+            }
+            SearchResult result;
+            int best = -1;
+            auto t1 = CLOCK::now();
+            for (const Point &goal : goals) {
+                if (FindPath(grid.View(), init, goal, context, route, &result) &&
+                    (best < 0 || result.cost < best)) {
+                    best = result.cost;
+                }
+                expansions_each += result.expansions;
+            }
+            auto t2 = CLOCK::now();
+            FindNearestPath(grid.View(), init, goals, context, route, &result);
+            auto t3 = CLOCK::now();
+            expansions_nearest += result.expansions;
+            t_each += std::chrono::duration<double, std::milli>(t2 - t1).count();
+            t_nearest += std::chrono::duration<double, std::milli>(t3 - t2).count();
+            if (result.cost != best) {
+                cout << "cost mismatch: " << result.cost << " vs. " << best << "\n";
+            }
+        }
+        cout << count << "\t" << t_each / queries << "\t\t\t" << t_nearest / queries << "\t\t"
+             << t_each / t_nearest << "\t" << expansions_each / queries << " / "
+             << expansions_nearest / queries << std::endl;
+    }
+}
+
+// many agents, one goal: one FindPath() per agent vs. one flow field that all
+// of them follow, and repairing the field vs. building it again after changes
+void BenchmarkFlowField() {
+    const int size = 1024;
+    const int agents = 200;
+    Grid grid = RandomBoard(size, 0.2, 24);
+    std::mt19937 rng(24);
+    auto random_free_cell = [&]() {
+        while (true) {
+            Point cell{int(rng() % size), int(rng() % size)};
+            if (grid(cell.x, cell.y) != State::kObstacle) {
+                return cell;
+            }
+        }
+    };
+    const Point goal = random_free_cell();
+    vector<Point> starts;
+    for (int i = 0; i < agents; i++) {
+        starts.push_back(random_free_cell());
+    }
+
+    SearchContext context;
+    vector<Point> route;
+    long long steps_astar = 0;
+    auto t1 = CLOCK::now();
+    for (const Point &start : starts) {
+        FindPath(grid.View(), start, goal, context, route);
+        steps_astar += route.size();
+    }
+    auto t2 = CLOCK::now();
+    FlowField<> field(grid.View(), goal);
+    auto t3 = CLOCK::now();
+    long long steps_field = 0;
+    for (const Point &start : starts) {
+        field.Follow(start, route);
+        steps_field += route.size();
+    }
+    auto t4 = CLOCK::now();
+    const double ms_astar = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    const double ms_build = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    const double ms_follow = std::chrono::duration<double, std::milli>(t4 - t3).count();
+    cout << size << "x" << size << ", " << agents << " agents, moves: "
+         << field.MoveBytes() / double(1 << 20) << " MB, with the distances for Update(): "
+         << field.MemoryBytes() / double(1 << 20) << " MB" << "\n";
+    cout << "FindPath() per agent [ms]\tbuild [ms]\tfollow all [ms]\tspeedup\tsteps (A* / field)" << "\n";
+    cout << ms_astar << "\t\t\t" << ms_build << "\t\t" << ms_follow << "\t\t"
+         << ms_astar / (ms_build + ms_follow) << "\t" << steps_astar << " / " << steps_field
+         << "\n";
+
+    cout << "flips\tupdate [ms]\tsettled\t\trebuild [ms]" << "\n";
+    for (int flips : {1, 10, 100}) {
+        vector<Point> cells;
+        for (int i = 0; i < flips; i++) {
+            Point cell{int(rng() % size), int(rng() % size)};
+            grid(cell.x, cell.y) =
+                grid(cell.x, cell.y) == State::kObstacle ? State::kEmpty : State::kObstacle;
+            cells.push_back(cell);
+        }
+        auto t5 = CLOCK::now();
+        field.Update(grid.View(), cells);
+        auto t6 = CLOCK::now();
+        const int settled = field.Settled();
+        FlowField<> rebuilt(grid.View(), goal);
+        auto t7 = CLOCK::now();
+        cout << flips << "\t" << std::chrono::duration<double, std::milli>(t6 - t5).count() << "\t\t"
+             << settled << "\t\t" << std::chrono::duration<double, std::milli>(t7 - t6).count()
+             << std::endl;
+    }
+}
+
+// CBS with dozens of agents: how many constraint tree nodes it takes, and how
+// many collisions the independently planned paths (the root) would have had
+void BenchmarkCbs() {
+    cout << "board\tagents\tms\tnodes\tlow-level expansions\tcost\tcost alone" << "\n";
+    for (int size : {32, 64}) {
+        Grid grid = RandomBoard(size, 0.1, 25);
+        for (int agents : {10, 25, 50}) {
+            std::mt19937 rng(size * 100 + agents);
+            vector<Query> queries;
+            vector<Point> starts;
+            vector<Point> goals;
+            while (static_cast<int>(queries.size()) < agents) {
+                Point a{int(rng() % size), int(rng() % size)};
+                Point b{int(rng() % size), int(rng() % size)};
+                if (grid(a.x, a.y) == State::kObstacle || grid(b.x, b.y) == State::kObstacle ||
+                    std::find(starts.begin(), starts.end(), a) != starts.end() ||
+                    std::find(goals.begin(), goals.end(), b) != goals.end()) {
+                    continue;
+                }
+                starts.push_back(a);
+                goals.push_back(b);
+                queries.push_back(Query{a, b});
+            }
+
+            // the sum of the shortest paths, ignoring the other agents
+            SearchContext context;
+            SearchResult alone;
+            int cost_alone = 0;
+            for (const Query &query : queries) {
+                SearchBoard(grid.View(), query.init, query.goal, context, &alone);
+                cost_alone += alone.cost;
+            }
+
+            ConflictBasedSearch<> cbs;
+            vector<vector<Point>> paths;
+            CbsResult result;
+            auto t1 = CLOCK::now();
+            cbs.Plan(grid.View(), queries, paths, &result);
+            auto t2 = CLOCK::now();
+            cout << size << "x" << size << "\t" << agents << "\t"
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() << "\t"
+                 << result.nodes << "\t" << result.expansions << "\t\t\t"
+                 << (result.found ? std::to_string(result.cost) : "-") << "\t" << cost_alone
+                 << std::endl;
+        }
+    }
+}
+
+// where the time of plain A* goes, from the SearchStats of each query. the
+// overhead of recording them: compare ms/query with a -DSEARCH_STATS=0 build
+void BenchmarkStats() {
+    const int size = 1024;
+    Grid grid = RandomBoard(size, 0.2, 21);
+    std::mt19937 rng(21);
+    vector<Query> queries;
+    while (queries.size() < 50) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            queries.push_back(Query{a, b});
+        }
+    }
+
+    SearchContext context;
+    vector<Point> route;
+    SearchStats total;
+    FindPath(grid.View(), queries[0].init, queries[0].goal, context, route); // warm-up
+    auto t1 = CLOCK::now();
+    for (const Query &query : queries) {
+        FindPath(grid.View(), query.init, query.goal, context, route);
+        const SearchStats &stats = context.Stats();
+        total.expansions += stats.expansions;
+        total.pushes += stats.pushes;
+        total.reopens += stats.reopens;
+        total.peak_open = std::max(total.peak_open, stats.peak_open);
+        total.peak_memory = std::max(total.peak_memory, stats.peak_memory);
+        total.neighbor_ms += stats.neighbor_ms;
+        total.open_list_ms += stats.open_list_ms;
+        total.total_ms += stats.total_ms;
+    }
+    auto t2 = CLOCK::now();
+    cout << size << "x" << size << ", " << queries.size() << " queries, stats "
+         << (kSearchStats ? "on" : "off") << "\n";
+    cout << "ms/query: " << std::chrono::duration<double, std::milli>(t2 - t1).count() / queries.size()
+         << "\n";
+    if (kSearchStats) {
+        cout << "expansions	pushes		re-opens	peak open	peak memory [MB]" << "\n";
+        cout << total.expansions << "	" << total.pushes << "	" << total.reopens << "		"
+             << total.peak_open << "		" << total.peak_memory / double(1 << 20) << "\n";
+        cout << "neighbors [ms]	open list [ms]	other [ms]	total [ms]" << "\n";
+        cout << total.neighbor_ms << "		" << total.open_list_ms << "		"
+             << total.total_ms - total.neighbor_ms - total.open_list_ms << "		"
+             << total.total_ms << std::endl;
+    }
+}
+
+// heap allocations per query once the reused buffers have grown (one warm-up
+// query first). SearchCellSort() takes and returns the board by value, that
+// copy is counted separately
+void BenchmarkAllocations() {
+    const int reps = 5;
+    cout << "size\tsearch\t\t\tallocs/query\tof which board copy" << "\n";
+    for (int size : {32, 64, 128}) {
+        Grid grid = RandomBoard(size, 0.15, 42);
+        auto board = grid.ToNested();
+        int init[2]{0, 0};
+        int goal[2]{size - 1, size - 1};
+        const int board_copy = size + 1;
+
+        auto per_query = [&](auto search) {
+            search();
+            const long long before = allocation_count.load();
+            for (int i = 0; i < reps; i++) {
+                search();
+            }
+            return double(allocation_count.load() - before) / reps;
+        };
+        std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+        vector<SearchNode> open_nodes;
+        const double cell_sort = per_query([&] { SearchCellSort(board, init, goal, open_nodes); });
+        SearchContext context;
+        vector<Point> route;
+        const double find_path = per_query([&] {
+            FindPath(grid.View(), Point{init[0], init[1]}, Point{goal[0], goal[1]}, context, route);
+        });
+        std::cout.clear();
+        cout << size << "x" << size << "\tSearchCellSort()\t" << cell_sort << "\t\t" << board_copy
+             << "\n";
+        cout << size << "x" << size << "\tFindPath()\t\t" << find_path << "\t\t0" << std::endl;
+    }
+}
+
+// throughput of BatchPlanner with 1..N worker threads on one shared board
+void BenchmarkBatch() {
+    const int size = 256;
+    const int queries = 10000;
+    Grid grid = RandomBoard(size, 0.2, 4);
+    std::mt19937 rng(31);
+    vector<Query> batch;
+    while (static_cast<int>(batch.size()) < queries) {
+        Point a{int(rng() % size), int(rng() % size)};
+        Point b{int(rng() % size), int(rng() % size)};
+        if (grid(a.x, a.y) != State::kObstacle && grid(b.x, b.y) != State::kObstacle) {
+            batch.push_back(Query{a, b});
+        }
+    }
+
+    cout << queries << " queries on " << size << "x" << size << " ("
+         << std::thread::hardware_concurrency() << " hardware threads)" << "\n";
+    cout << "threads\tqueries/s\tspeedup" << "\n";
+    double base = 0;
+    const int max_threads = std::max(4, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        BatchPlanner planner(threads);
+        planner.Solve(grid.View(), vector<Query>(batch.begin(), batch.begin() + 100)); // warm-up
+        auto t1 = CLOCK::now();
+        planner.Solve(grid.View(), batch);
+        auto t2 = CLOCK::now();
+        const double rate = queries / std::chrono::duration<double>(t2 - t1).count();
+        if (threads == 1) {
+            base = rate;
+        }
+        cout << threads << "\t" << rate << "\t\t" << rate / base << std::endl;
+    }
+}
+
+int main( int argc, char *argv[] ) {
+    const std::string section = argc > 1 ? argv[1] : "all";
+
+    if (section == "all" || section == "open_list") {
+        BenchmarkOpenList();
+    }
+    if (section == "all" || section == "loader") {
+        BenchmarkLoaders();
+    }
+    if (section == "all" || section == "binary") {
+        BenchmarkBinaryBoard();
+    }
+    if (section == "all" || section == "bitmap") {
+        BenchmarkBitmap();
+    }
+    if (section == "all" || section == "jps") {
+        BenchmarkJumpPoint();
+    }
+    if (section == "all" || section == "bidirectional") {
+        BenchmarkBidirectional();
+    }
+    if (section == "all" || section == "hpa") {
+        BenchmarkHierarchical();
+    }
+    if (section == "all" || section == "context") {
+        BenchmarkSearchContext();
+    }
+    if (section == "all" || section == "path") {
+        BenchmarkPathFormat();
+    }
+    if (section == "all" || section == "neighborhood") {
+        BenchmarkNeighborhood();
+    }
+    if (section == "all" || section == "terrain") {
+        BenchmarkTerrain();
+    }
+    if (section == "all" || section == "dstar") {
+        BenchmarkDStarLite();
+    }
+    if (section == "all" || section == "anytime") {
+        BenchmarkAnytime();
+    }
+    if (section == "all" || section == "alt") {
+        BenchmarkLandmarks();
+    }
+    if (section == "all" || section == "components") {
+        BenchmarkComponents();
+    }
+    if (section == "all" || section == "hda") {
+        BenchmarkHda();
+    }
+    if (section == "all" || section == "tiled") {
+        BenchmarkTiledBoard();
+    }
+    if (section == "all" || section == "nearest") {
+        BenchmarkNearestGoal();
+    }
+    if (section == "all" || section == "flowfield") {
+        BenchmarkFlowField();
+    }
+    if (section == "all" || section == "cbs") {
+        BenchmarkCbs();
+    }
+    if (section == "all" || section == "stats") {
+        BenchmarkStats();
+    }
+    if (section == "all" || section == "allocations") {
+        BenchmarkAllocations();
+    }
+    if (section == "all" || section == "batch") {
+        BenchmarkBatch();
+    }
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+// pre-compiler instructions
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "batch_planner.h"
+#include "bidirectional_search.h"
+#include "board_generators.h"
+#include "components.h"
+#include "grid_search.h"
+#include "hpa_star.h"
+#include "jump_point_search.h"
+#include "neighborhood.h"
+
+/* to build and run:
+ * $ cd obj/
+ * $ g++ -O2 -pthread ../src/benchmark_suite.cpp -o ./benchmark_suite.o
+ * $ ./benchmark_suite.o [max size] [results.json]
+ * sizes double from 64 up to max size (default 1024, at most 8192); the
+ * results go to stdout unless a file is given, progress to stderr.
+ */
+
+/* BENCHMARK SUITE:
+ * Every algorithm on every generated board, reported as one JSON document so
+ * runs can be compared over time. Boards: random obstacles at 10, 20 and 30 %,
+ * perfect mazes, rooms and corridors, and open fields. Queries are random
+ * pairs of free cells in the same component (a ComponentIndex picks them), so
+ * the numbers aren't dominated by searches that flood a whole board to give up.
+ *
+ * Per (board, size, algorithm):
+ *   queries_per_sec, expansions_per_sec  over all queries of the run
+ *   latency_ms                           p50, p90, p99 and max of one query
+ *   precompute_ms                        e.g. the HPA* abstract graph
+ *   peak_rss_kb                          high-water mark of the process so far
+ * Peak memory is per process: it only grows, and runs go from small to big.
+ */
+
+using CLOCK = std::chrono::steady_clock;
+using std::cout;
+using std::string;
+using std::vector;
+
+struct BoardSpec {
+    string name;
+    std::function<Grid( int size, unsigned seed )> make;
+};
+
+struct Run {
+    string board;
+    int size = 0;
+    string algorithm;
+    int queries = 0;
+    int found = 0;
+    long long expansions = 0;
+    double total_ms = 0;
+    double precompute_ms = 0;
+    vector<double> latencies_ms;
+    long peak_rss_kb = 0;
+};
+
+// one query: fills result, returns nothing - timing happens around it
+using Algorithm = std::function<void( Point init, Point goal, SearchResult *result )>;
+
+long PeakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// the p-th percentile (0..100) of sorted values, nearest rank
+double Percentile( const vector<double> &sorted, double p ) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const std::size_t rank = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+// count pairs of free cells from the same component
+vector<Query> MakeQueries( const Grid &grid, int count, unsigned seed ) {
+    ComponentIndex<> components(grid.View());
+    std::mt19937 rng(seed);
+    vector<Query> queries;
+    for (int attempt = 0; static_cast<int>(queries.size()) < count && attempt < 100 * count;
+         attempt++) {
+        Point a{int(rng() % grid.Rows()), int(rng() % grid.Cols())};
+        Point b{int(rng() % grid.Rows()), int(rng() % grid.Cols())};
+        if (components.Connected(a, b)) {
+            queries.push_back(Query{a, b});
+        }
+    }
+    return queries;
+}
+
+Run Measure( const string &board, int size, const string &algorithm, double precompute_ms,
+             const vector<Query> &queries, const Algorithm &search ) {
+    Run run;
+    run.board = board;
+    run.size = size;
+    run.algorithm = algorithm;
+    run.precompute_ms = precompute_ms;
+    std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+    for (const Query &query : queries) {
+        SearchResult result;
+        auto t1 = CLOCK::now();
+        search(query.init, query.goal, &result);
+        auto t2 = CLOCK::now();
+        const double ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+        run.latencies_ms.push_back(ms);
+        run.total_ms += ms;
+        run.expansions += result.expansions;
+        run.found += result.found;
+        run.queries++;
+    }
+    std::cout.clear();
+    std::sort(run.latencies_ms.begin(), run.latencies_ms.end());
+    run.peak_rss_kb = PeakRssKb();
+    std::cerr << board << " " << size << " " << algorithm << ": " << run.queries << " queries, "
+              << run.total_ms << " ms" << std::endl;
+    return run;
+}
+
+string ToJson( const vector<Run> &runs ) {
+    std::ostringstream json;
+    json << "{\n  \"suite\": \"route-planner\",\n  \"results\": [";
+    for (std::size_t i = 0; i < runs.size(); i++) {
+        const Run &run = runs[i];
+        const double seconds = run.total_ms / 1000.0;
+        json << (i ? "," : "") << "\n    {\"board\": \"" << run.board << "\", \"size\": "
+             << run.size << ", \"algorithm\": \"" << run.algorithm << "\", \"queries\": "
+             << run.queries << ", \"found\": " << run.found << ", \"expansions\": "
+             << run.expansions << ",\n     \"queries_per_sec\": "
+             << (seconds > 0 ? run.queries / seconds : 0) << ", \"expansions_per_sec\": "
+             << (seconds > 0 ? run.expansions / seconds : 0) << ", \"precompute_ms\": "
+             << run.precompute_ms << ",\n     \"latency_ms\": {\"p50\": "
+             << Percentile(run.latencies_ms, 50) << ", \"p90\": "
+             << Percentile(run.latencies_ms, 90) << ", \"p99\": "
+             << Percentile(run.latencies_ms, 99) << ", \"max\": "
+             << (run.latencies_ms.empty() ? 0 : run.latencies_ms.back())
+             << "}, \"peak_rss_kb\": " << run.peak_rss_kb << "}";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+}
+
+int main( int argc, char *argv[] ) {
+    const int max_size = std::min(8192, argc > 1 ? std::atoi(argv[1]) : 1024);
+    const string output = argc > 2 ? argv[2] : "";
+
+    const vector<BoardSpec> boards{
+        {"random-10", [](int size, unsigned seed) { return RandomBoard(size, 0.1, seed); }},
+        {"random-20", [](int size, unsigned seed) { return RandomBoard(size, 0.2, seed); }},
+        {"random-30", [](int size, unsigned seed) { return RandomBoard(size, 0.3, seed); }},
+        {"maze", [](int size, unsigned seed) { return MazeBoard(size, seed); }},
+        {"rooms", [](int size, unsigned seed) { return RoomsBoard(size, 15, seed); }},
+        {"open", [](int size, unsigned) { return OpenBoard(size); }},
+    };
+
+    vector<Run> runs;
+    for (int size = 64; size <= max_size; size *= 2) {
+        // fewer queries on the big boards, where one can take seconds
+        const int count = std::max(4, 256 * 64 / size);
+        for (const BoardSpec &spec : boards) {
+            const Grid grid = spec.make(size, size);
+            const vector<Query> queries = MakeQueries(grid, count, size + 1);
+            SearchContext context;
+            BidirectionalContext sides;
+            vector<Point> path;
+
+            runs.push_back(Measure(spec.name, size, "astar", 0, queries,
+                [&](Point init, Point goal, SearchResult *result) {
+                    FindPath(grid.View(), init, goal, context, path, result);
+                }));
+            runs.push_back(Measure(spec.name, size, "astar-8", 0, queries,
+                [&](Point init, Point goal, SearchResult *result) {
+                    FindPath<EightConnectedNoCornerCutting>(grid.View(), init, goal, context,
+                                                            path, result);
+                }));
+
+            auto t1 = CLOCK::now();
+            PassabilityBitmap free_cells(grid);
+            auto t2 = CLOCK::now();
+            runs.push_back(Measure(spec.name, size, "jps",
+                std::chrono::duration<double, std::milli>(t2 - t1).count(), queries,
+                [&](Point init, Point goal, SearchResult *result) {
+                    JumpPointSearch(grid.View(), free_cells, init, goal, context, result);
+                }));
+            runs.push_back(Measure(spec.name, size, "bidirectional", 0, queries,
+                [&](Point init, Point goal, SearchResult *result) {
+                    BidirectionalSearch(grid.View(), init, goal, sides, result);
+                }));
+
+            HierarchicalMap map;
+            auto t3 = CLOCK::now();
+            map.Build(grid.View());
+            auto t4 = CLOCK::now();
+            runs.push_back(Measure(spec.name, size, "hpa",
+                std::chrono::duration<double, std::milli>(t4 - t3).count(), queries,
+                [&](Point init, Point goal, SearchResult *result) {
+                    map.FindPath(grid.View(), init, goal, result);
+                }));
+        }
+    }
+
+    const string json = ToJson(runs);
+    if (output.empty()) {
+        cout << json;
+    } else {
+        std::ofstream(output) << json;
+    }
+    return 0;
+}
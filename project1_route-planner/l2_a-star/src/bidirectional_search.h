@@ -0,0 +1,166 @@
+#ifndef BIDIRECTIONAL_SEARCH_H
+#define BIDIRECTIONAL_SEARCH_H
+
+#include <algorithm>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "open_list.h"
+#include "search_context.h"
+
+/* BIDIRECTIONAL A*:
+ * Two A* searches on the same board: a forward one from init towards goal and
+ * a backward one from goal towards init. The board is undirected, so the
+ * backward search can use the very same neighbors. Whichever frontier is
+ * smaller is expanded next.
+ *
+ * Both sides use the Manhattan Heuristic(), but "balanced" (average) instead of
+ * plain: with h_goal(v) = Heuristic(v, goal) and h_init(v) = Heuristic(v, init)
+ *   forward key  = g_fwd(v) + (h_goal(v) - h_init(v)) / 2
+ *   backward key = g_bwd(v) + (h_init(v) - h_goal(v)) / 2
+ * The average of two consistent heuristics is consistent, and the two
+ * potentials add up to 0 - which gives a tight stopping rule. (Keys are stored
+ * doubled so they stay integers.)
+ *
+ * Every time a node gets a g-value from one side while the other side has
+ * already reached it, the two half paths form a full path and `best` (mu in
+ * the literature) is updated.
+ *
+ * Termination: a path shorter than `best` would have to run through a node v
+ * that neither side has expanded yet, and its length is at least
+ *   (g_fwd(v) + p(v)) + (g_bwd(v) - p(v)) >= top key forward + top key backward
+ * so once the two top keys add up to `best`, `best` is optimal.
+ */
+
+// the per-query state of BidirectionalSearch(), reused from one query to the
+// next: a SearchContext for each side
+struct BidirectionalContext {
+    SearchContext sides[2];     // 0 searches forward from init, 1 backward from goal
+};
+
+/**
+ * Bidirectional A* on a read-only board, with all the per-query state in the
+ * context. Returns whether goal was reached; cost and expansions go to result.
+ */
+bool BidirectionalSearch( const GridView &board, Point init, Point goal,
+                          BidirectionalContext &context, SearchResult *result = nullptr ) {
+    const int kInfinity = SearchContext::kInfinity;
+    SearchResult summary;
+    SearchContext *sides = context.sides;
+    for (int s = 0; s < 2; s++) {
+        sides[s].Reset(board.Size());
+    }
+    if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+        board(init.x, init.y) == State::kObstacle || board(goal.x, goal.y) == State::kObstacle) {
+        if (result) {
+            *result = summary;
+        }
+        return false;
+    }
+
+    const Point origins[2]{init, goal};
+
+    // doubled key of (x, y) at g-value g on side s, ties go to the node
+    // closer to that side's target
+    auto key = [&](int s, int x, int y, int g) {
+        const int h_target = Heuristic(x, y, origins[1 - s].x, origins[1 - s].y);
+        const int h_origin = Heuristic(x, y, origins[s].x, origins[s].y);
+        return OpenKey{2 * g + h_target - h_origin, h_target};
+    };
+    for (int s = 0; s < 2; s++) {
+        const int id = board.Index(origins[s].x, origins[s].y);
+        sides[s].Set(id, 0, -1);
+        sides[s].Open().Push(id, key(s, origins[s].x, origins[s].y, 0));
+    }
+
+    const int init_id = board.Index(init.x, init.y);
+    const int goal_id = board.Index(goal.x, goal.y);
+    int best = init_id == goal_id ? 0 : kInfinity;
+    const int delta[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+
+    while (!sides[0].Open().Empty() && !sides[1].Open().Empty()) {
+        const long lower_bound = long(sides[0].Open().Top().key.f) + sides[1].Open().Top().key.f;
+        if (2 * long(best) <= lower_bound) {
+            break;
+        }
+
+        // expand the smaller frontier
+        const int s = sides[0].Open().Size() <= sides[1].Open().Size() ? 0 : 1;
+        SearchContext &side = sides[s];
+        const SearchContext &other = sides[1 - s];
+
+        const int current_id = side.Open().Pop().id;
+        side.Close(current_id);
+        summary.expansions++;
+
+        const int current_x = board.IndexX(current_id);
+        const int current_y = board.IndexY(current_id);
+        const int g = side.G(current_id) + 1;
+        for (auto d : delta) {
+            const int x = current_x + d[0];
+            const int y = current_y + d[1];
+            if (!board.InBounds(x, y) || board(x, y) == State::kObstacle) {
+                continue;
+            }
+            const int id = board.Index(x, y);
+            if (side.Closed(id) || g >= side.G(id)) {
+                continue;
+            }
+            side.Set(id, g, current_id);
+            side.Open().PushOrDecrease(id, key(s, x, y, g));
+            // the two searches meet
+            const int other_g = other.G(id);
+            if (other_g != kInfinity) {
+                best = std::min(best, g + other_g);
+            }
+        }
+    }
+
+    if (best != kInfinity) {
+        summary.found = true;
+        summary.cost = best;
+    }
+    if (result) {
+        *result = summary;
+    }
+    return summary.found;
+}
+
+/**
+ * BidirectionalSearch() that returns the board with the same marking as
+ * Search(): kPath for cells either side expanded, kClosed for the ones they
+ * only reached. Only the returned Grid is allocated.
+ */
+Grid BidirectionalSearch( const GridView &board, int init[2], int goal[2],
+                          BidirectionalContext &context, SearchResult *result = nullptr ) {
+    Point start{init[0], init[1]};
+    Point finish{goal[0], goal[1]};
+    if (!BidirectionalSearch(board, start, finish, context, result)) {
+        cout << "No path found!" << "\n";
+        return Grid{};
+    }
+    Grid grid(board);
+    const SearchContext &forward = context.sides[0];
+    const SearchContext &backward = context.sides[1];
+    State *cells = grid.Data();
+    for (int id = 0; id < grid.Size(); id++) {
+        if (forward.Closed(id) || backward.Closed(id)) {
+            cells[id] = State::kPath;
+        } else if (forward.Seen(id) || backward.Seen(id)) {
+            cells[id] = State::kClosed;
+        }
+    }
+    grid(start.x, start.y) = State::kStart;
+    grid(finish.x, finish.y) = State::kFinish;
+    return grid;
+}
+
+// BidirectionalSearch() with a context of its own
+Grid BidirectionalSearch( const GridView &board, int init[2], int goal[2],
+                          SearchResult *result = nullptr ) {
+    BidirectionalContext context;
+    return BidirectionalSearch(board, init, goal, context, result);
+}
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef BINARY_BOARD_H
+#define BINARY_BOARD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "board_io.h"
+#include "mapped_file.h"
+
+/* BINARY BOARD FORMAT (version 1):
+ * The text .board format takes ~2 bytes per cell and has to be parsed on every
+ * run. A binary board is a fixed 32-byte header followed by the cell payload:
+ *
+ *   offset  size  field
+ *   0       4     magic "BORD"
+ *   4       2     version (kBinaryBoardVersion)
+ *   6       2     encoding (BoardEncoding)
+ *   8       4     rows
+ *   12      4     cols
+ *   16      4     stride - payload units per row (see below)
+ *   20      4     payload offset from the start of the file
+ *   24      8     payload size in bytes
+ *
+ * Encodings:
+ *   kState8 - one State byte per cell, stride = cols. The payload IS the cell
+ *             array of a Grid, so a mapped file can be searched in place.
+ *   kBit1   - one bit per cell (1 = kObstacle, LSB first), every row padded to
+ *             whole 64-bit words, stride = words per row. 8x smaller.
+ *
+ * The payload starts at a 64-byte boundary, and all integers are stored in the
+ * host (little-endian) byte order.
+ */
+
+const char kBinaryBoardMagic[4]{'B', 'O', 'R', 'D'};
+const std::uint16_t kBinaryBoardVersion = 1;
+const std::uint32_t kBinaryBoardPayloadOffset = 64;
+
+enum class BoardEncoding : std::uint16_t {kState8 = 0, kBit1 = 1};
+
+struct BinaryBoardHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t encoding;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t stride;
+    std::uint32_t payload_offset;
+    std::uint64_t payload_size;
+};
+
+static_assert(sizeof(BinaryBoardHeader) == 32, "BinaryBoardHeader must be 32 bytes");
+
+// bytes per payload unit for the given encoding
+inline std::uint64_t EncodingUnitSize( BoardEncoding encoding ) {
+    return encoding == BoardEncoding::kBit1 ? sizeof(std::uint64_t) : sizeof(State);
+}
+
+// payload units per row for the given encoding
+inline std::uint32_t EncodingStride( BoardEncoding encoding, std::uint32_t cols ) {
+    return encoding == BoardEncoding::kBit1 ? (cols + 63) / 64 : cols;
+}
+
+bool WriteBinaryBoard( const Grid &grid, const std::string &path,
+                       BoardEncoding encoding = BoardEncoding::kState8 ) {
+    BinaryBoardHeader header{};
+    std::memcpy(header.magic, kBinaryBoardMagic, sizeof(header.magic));
+    header.version = kBinaryBoardVersion;
+    header.encoding = static_cast<std::uint16_t>(encoding);
+    header.rows = grid.Rows();
+    header.cols = grid.Cols();
+    header.stride = EncodingStride(encoding, header.cols);
+    header.payload_offset = kBinaryBoardPayloadOffset;
+    header.payload_size = std::uint64_t(header.rows) * header.stride * EncodingUnitSize(encoding);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const std::vector<char> padding(kBinaryBoardPayloadOffset - sizeof(header), 0);
+    file.write(padding.data(), padding.size());
+
+    if (encoding == BoardEncoding::kState8) {
+        for (int x = 0; x < grid.Rows(); x++) {
+            file.write(reinterpret_cast<const char *>(grid.Row(x)), grid.Cols());
+        }
+    } else {
+        std::vector<std::uint64_t> words(header.stride);
+        for (int x = 0; x < grid.Rows(); x++) {
+            std::fill(words.begin(), words.end(), 0);
+            const State *row = grid.Row(x);
+            for (int y = 0; y < grid.Cols(); y++) {
+                if (row[y] == State::kObstacle) {
+                    words[y / 64] |= std::uint64_t(1) << (y % 64);
+                }
+            }
+            file.write(reinterpret_cast<const char *>(words.data()),
+                       words.size() * sizeof(std::uint64_t));
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+// converts a text .board file into a binary board
+bool ConvertBoardFile( const std::string &board_path, const std::string &binary_path,
+                       BoardEncoding encoding = BoardEncoding::kState8 ) {
+    Grid grid = LoadBoardMmap(board_path);
+    if (grid.Empty()) {
+        return false;
+    }
+    return WriteBinaryBoard(grid, binary_path, encoding);
+}
+
+/* MAPPED BOARD:
+ * A binary board file mapped into memory. Opening one validates the header and,
+ * for kState8, that every byte is a State - nothing is parsed or copied, so
+ * that is one pass over the file. A kState8 board can then be used in place
+ * through View(); a kBit1 board exposes its packed rows through Bits() and is
+ * expanded with ToGrid(). A kBit1 payload is checked for padding bits past
+ * the last column, which have to be 0.
+ */
+class MappedBoard {
+  public:
+    MappedBoard() = default;
+    explicit MappedBoard( const std::string &path ) { Open(path); }
+
+    // returns false if the file is missing, truncated, corrupt or not a version 1 board
+    bool Open( const std::string &path ) {
+        if (!file_.Open(path) || file_.Size() < sizeof(BinaryBoardHeader)) {
+            file_.Close();
+            return false;
+        }
+        std::memcpy(&header_, file_.Data(), sizeof(header_));
+        const BoardEncoding encoding = Encoding();
+        const bool valid =
+            std::memcmp(header_.magic, kBinaryBoardMagic, sizeof(header_.magic)) == 0 &&
+            header_.version == kBinaryBoardVersion &&
+            (encoding == BoardEncoding::kState8 || encoding == BoardEncoding::kBit1) &&
+            header_.stride == EncodingStride(encoding, header_.cols) &&
+            header_.payload_offset >= sizeof(BinaryBoardHeader) &&
+            header_.payload_offset % alignof(std::uint64_t) == 0 &&
+            header_.payload_size == std::uint64_t(header_.rows) * header_.stride * EncodingUnitSize(encoding) &&
+            header_.payload_offset + header_.payload_size <= file_.Size() &&
+            (encoding == BoardEncoding::kState8 ? ValidStates() : ZeroPadding());
+        if (!valid) {
+            file_.Close();
+        }
+        return valid;
+    }
+
+    bool IsOpen() const { return file_.IsOpen(); }
+    const BinaryBoardHeader &Header() const { return header_; }
+    BoardEncoding Encoding() const { return static_cast<BoardEncoding>(header_.encoding); }
+    int Rows() const { return header_.rows; }
+    int Cols() const { return header_.cols; }
+
+    // the cells, in place. empty unless the board is kState8
+    GridView View() const {
+        if (!IsOpen() || Encoding() != BoardEncoding::kState8) {
+            return GridView{};
+        }
+        return GridView(reinterpret_cast<const State *>(Payload()),
+                        header_.rows, header_.cols, header_.stride);
+    }
+
+    // the packed rows (header.stride words each). nullptr unless kBit1
+    const std::uint64_t *Bits() const {
+        if (!IsOpen() || Encoding() != BoardEncoding::kBit1) {
+            return nullptr;
+        }
+        return reinterpret_cast<const std::uint64_t *>(Payload());
+    }
+
+    // copies (or expands) the board into a mutable Grid
+    Grid ToGrid() const {
+        if (!IsOpen()) {
+            return Grid{};
+        }
+        if (Encoding() == BoardEncoding::kState8) {
+            return Grid(View());
+        }
+        Grid grid(header_.rows, header_.cols);
+        const std::uint64_t *words = Bits();
+        for (int x = 0; x < grid.Rows(); x++) {
+            const std::uint64_t *row_words = words + std::uint64_t(x) * header_.stride;
+            State *row = grid.Row(x);
+            // only visit the set bits of every word
+            for (std::uint32_t w = 0; w < header_.stride; w++) {
+                for (std::uint64_t word = row_words[w]; word != 0; word &= word - 1) {
+                    row[64 * w + __builtin_ctzll(word)] = State::kObstacle;
+                }
+            }
+        }
+        return grid;
+    }
+
+  private:
+    const char *Payload() const { return file_.Data() + header_.payload_offset; }
+
+    // whether every byte of a kState8 payload is one of the State values
+    bool ValidStates() const {
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(Payload());
+        std::uint8_t highest = 0;
+        for (std::uint64_t i = 0; i < header_.payload_size; i++) {
+            highest = std::max(highest, bytes[i]);
+        }
+        return highest <= static_cast<std::uint8_t>(State::kFinish);
+    }
+
+    // whether the bits past the last column in every row of a kBit1 payload are 0
+    bool ZeroPadding() const {
+        if (header_.cols % 64 == 0) {
+            return true;
+        }
+        const auto *words = reinterpret_cast<const std::uint64_t *>(Payload());
+        const std::uint64_t padding = ~std::uint64_t(0) << (header_.cols % 64);
+        std::uint64_t found = 0;
+        for (std::uint64_t x = 0; x < header_.rows; x++) {
+            found |= words[(x + 1) * header_.stride - 1] & padding;
+        }
+        return found == 0;
+    }
+
+    MappedFile file_;
+    BinaryBoardHeader header_{};
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// a State is stored once per cell, so keep it to a single byte
+enum class State : std::uint8_t {kEmpty, kObstacle, kClosed, kPath, kStart, kFinish};
+
+// a cell of the board, same (row, column) order as init[2] and goal[2]
+struct Point {
+    int x;
+    int y;
+};
+
+inline bool operator==( const Point &a, const Point &b ) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=( const Point &a, const Point &b ) { return !(a == b); }
+
+/* GRID VIEW:
+ * Read-only, non-owning view of a row-major board - e.g. a Grid, or the cell
+ * payload of a memory-mapped binary board file. Same accessors as Grid.
+ */
+class GridView {
+  public:
+    GridView() = default;
+
+    GridView( const State *data, int rows, int cols, int stride )
+        : data_(data), rows_(rows), cols_(cols), stride_(stride) {}
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    int Stride() const { return stride_; }
+    int Size() const { return rows_ * stride_; }
+    bool Empty() const { return rows_ == 0 || cols_ == 0; }
+
+    bool InBounds( int x, int y ) const {
+        return x >= 0 && x < rows_ && y >= 0 && y < cols_;
+    }
+
+    int Index( int x, int y ) const { return x * stride_ + y; }
+    int IndexX( int index ) const { return index / stride_; }
+    int IndexY( int index ) const { return index % stride_; }
+
+    const State &operator()( int x, int y ) const { return data_[Index(x, y)]; }
+    const State *Row( int x ) const { return data_ + x * stride_; }
+    const State *Data() const { return data_; }
+
+  private:
+    const State *data_ = nullptr;
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+};
+
+// FNV-1a over the board size and which cells are obstacles - tells whether a
+// precomputation saved to disk still belongs to a board
+inline std::uint64_t BoardHash( const GridView &board ) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+    mix(board.Rows());
+    mix(board.Cols());
+    for (int x = 0; x < board.Rows(); x++) {
+        const State *row = board.Row(x);
+        for (int y = 0; y < board.Cols(); y++) {
+            mix(row[y] == State::kObstacle);
+        }
+    }
+    return hash;
+}
+
+/* GRID:
+ * A board stored as one contiguous, row-major buffer instead of a
+ * vector<vector<State>>. Cell (x, y) - row x, column y, same convention as the
+ * rest of grid_search - lives at cells_[x * stride + y].
+ *
+ * One allocation for the whole board means no row pointers to chase, and the
+ * 4 neighbors of a cell are always at index +-1 and +-stride. With a 1-byte
+ * State a 10k x 10k board takes 100 MB.
+ */
+class Grid {
+  public:
+    Grid() = default;
+
+    Grid( int rows, int cols, State fill = State::kEmpty )
+        : rows_(rows), cols_(cols), stride_(cols), cells_(rows * cols, fill) {}
+
+    // deep copy of a view
+    explicit Grid( const GridView &view ) : Grid(view.Rows(), view.Cols()) {
+        for (int x = 0; x < rows_; x++) {
+            std::copy(view.Row(x), view.Row(x) + cols_, Row(x));
+        }
+    }
+
+    explicit Grid( const std::vector<std::vector<State>> &board )
+        : Grid(board.size(), board.empty() ? 0 : board[0].size()) {
+        for (int x = 0; x < rows_; x++) {
+            for (int y = 0; y < cols_ && y < static_cast<int>(board[x].size()); y++) {
+                (*this)(x, y) = board[x][y];
+            }
+        }
+    }
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    int Stride() const { return stride_; }
+
+    // number of cell slots, i.e. the range of Index()
+    int Size() const { return rows_ * stride_; }
+    bool Empty() const { return rows_ == 0 || cols_ == 0; }
+
+    bool InBounds( int x, int y ) const {
+        return x >= 0 && x < rows_ && y >= 0 && y < cols_;
+    }
+
+    int Index( int x, int y ) const { return x * stride_ + y; }
+    int IndexX( int index ) const { return index / stride_; }
+    int IndexY( int index ) const { return index % stride_; }
+
+    State &operator()( int x, int y ) { return cells_[Index(x, y)]; }
+    const State &operator()( int x, int y ) const { return cells_[Index(x, y)]; }
+
+    State *Row( int x ) { return cells_.data() + x * stride_; }
+    const State *Row( int x ) const { return cells_.data() + x * stride_; }
+
+    State *Data() { return cells_.data(); }
+    const State *Data() const { return cells_.data(); }
+
+    GridView View() const { return GridView(cells_.data(), rows_, cols_, stride_); }
+
+    // back to the nested representation used by the lesson functions
+    std::vector<std::vector<State>> ToNested() const {
+        std::vector<std::vector<State>> board;
+        for (int x = 0; x < rows_; x++) {
+            board.emplace_back(Row(x), Row(x) + cols_);
+        }
+        return board;
+    }
+
+    bool operator==( const Grid &other ) const {
+        return rows_ == other.rows_ && cols_ == other.cols_ &&
+               stride_ == other.stride_ && cells_ == other.cells_;
+    }
+    bool operator!=( const Grid &other ) const { return !(*this == other); }
+
+  private:
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+    std::vector<State> cells_;
+};
+
+#endif
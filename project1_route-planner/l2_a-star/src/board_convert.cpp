@@ -0,0 +1,41 @@
+// pre-compiler instructions
+#include <iostream>
+#include <string>
+
+#include "binary_board.h"
+
+/* to build and run:
+ * $ cd obj/
+ * $ g++ -O2 ../src/board_convert.cpp -o ./board_convert.o
+ * $ ./board_convert.o ../data/1.board ../data/1.bin [state8|bit1]
+ */
+
+int main( int argc, char *argv[] ) {
+    if (argc < 3) {
+        std::cout << "usage: " << argv[0] << " <input.board> <output.bin> [state8|bit1]" << "\n";
+        return 1;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+    const std::string name = argc > 3 ? argv[3] : "state8";
+
+    BoardEncoding encoding;
+    if (name == "state8") {
+        encoding = BoardEncoding::kState8;
+    } else if (name == "bit1") {
+        encoding = BoardEncoding::kBit1;
+    } else {
+        std::cout << "unknown encoding: " << name << "\n";
+        return 1;
+    }
+
+    if (!ConvertBoardFile(input, output, encoding)) {
+        std::cout << "could not convert " << input << " to " << output << "\n";
+        return 1;
+    }
+
+    MappedBoard board(output);
+    std::cout << input << " -> " << output << " (" << board.Rows() << "x" << board.Cols()
+              << ", " << name << ", " << board.Header().payload_size << " payload bytes)" << "\n";
+    return 0;
+}
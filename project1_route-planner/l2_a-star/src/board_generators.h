@@ -0,0 +1,151 @@
+#ifndef BOARD_GENERATORS_H
+#define BOARD_GENERATORS_H
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+
+/* BOARD GENERATORS:
+ * Synthetic square boards for tests and benchmarks. Every generator is
+ * deterministic for a given seed and leaves the two corners (0, 0) and
+ * (size - 1, size - 1) free so they can be used as init and goal.
+ */
+
+// roughly density * 100 % of the cells are obstacles ("cluttered" boards)
+Grid RandomBoard( int size, double density, unsigned seed ) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution is_obstacle(density);
+    Grid grid(size, size);
+    for (int x = 0; x < size; x++) {
+        State *row = grid.Row(x);
+        for (int y = 0; y < size; y++) {
+            if (is_obstacle(rng)) {
+                row[y] = State::kObstacle;
+            }
+        }
+    }
+    grid(0, 0) = State::kEmpty;
+    grid(size - 1, size - 1) = State::kEmpty;
+    return grid;
+}
+
+// no obstacles at all
+Grid OpenBoard( int size ) {
+    return Grid(size, size);
+}
+
+// perfect maze (exactly one path between any two free cells), carved with an
+// iterative randomized depth-first search. rooms are the cells with two even
+// coordinates, the walls between them are knocked out as the DFS goes.
+Grid MazeBoard( int size, unsigned seed ) {
+    std::mt19937 rng(seed);
+    Grid grid(size, size, State::kObstacle);
+    const int delta[4][2]{{-2, 0}, {0, -2}, {2, 0}, {0, 2}};
+
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    grid(0, 0) = State::kEmpty;
+    while (!stack.empty()) {
+        const auto [x, y] = stack.back();
+        int options[4];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            const int nx = x + delta[i][0];
+            const int ny = y + delta[i][1];
+            if (grid.InBounds(nx, ny) && grid(nx, ny) == State::kObstacle) {
+                options[count++] = i;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int *d = delta[options[rng() % count]];
+        grid(x + d[0] / 2, y + d[1] / 2) = State::kEmpty;
+        grid(x + d[0], y + d[1]) = State::kEmpty;
+        stack.emplace_back(x + d[0], y + d[1]);
+    }
+
+    // with an even size the far corner isn't a room, connect it to one
+    const int last = size - 1;
+    if (last % 2 == 1) {
+        grid(last, last) = State::kEmpty;
+        grid(last - 1, last) = State::kEmpty;
+    }
+    return grid;
+}
+
+// rooms of room_size x room_size cells behind one-cell walls. every room has
+// a 2-cell door to each room of a random spanning tree, and to any other
+// neighbor with probability extra_doors, so the whole map is connected.
+Grid RoomsBoard( int size, int room_size, unsigned seed, double extra_doors = 0.3 ) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution extra(extra_doors);
+    Grid grid(size, size);
+    const int step = room_size + 1;
+    for (int x = 0; x < size; x++) {
+        for (int y = 0; y < size; y++) {
+            // no wall along the far edges, there is no room behind it
+            if ((x % step == room_size && x < size - 1) ||
+                (y % step == room_size && y < size - 1)) {
+                grid(x, y) = State::kObstacle;
+            }
+        }
+    }
+
+    // the door in the wall between room (i, j) and the next one down or
+    // right. rooms along the far edges may be cut short
+    auto open_door = [&](int i, int j, bool down) {
+        const int extent = std::min(room_size, size - (down ? j : i) * step);
+        const int offset = rng() % std::max(1, extent - 1);
+        for (int k = offset; k < offset + 2 && k < extent; k++) {
+            const int x = down ? i * step + room_size : i * step + k;
+            const int y = down ? j * step + k : j * step + room_size;
+            grid(x, y) = State::kEmpty;
+        }
+    };
+
+    // spanning tree: randomized depth-first search over the rooms
+    const int rooms = (size + step - 1) / step;
+    const int delta[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+    std::vector<char> visited(rooms * rooms, 0);
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    visited[0] = 1;
+    while (!stack.empty()) {
+        const auto [i, j] = stack.back();
+        int options[4];
+        int count = 0;
+        for (int d = 0; d < 4; d++) {
+            const int ni = i + delta[d][0];
+            const int nj = j + delta[d][1];
+            if (ni >= 0 && ni < rooms && nj >= 0 && nj < rooms && !visited[ni * rooms + nj]) {
+                options[count++] = d;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const int d = options[rng() % count];
+        const int ni = i + delta[d][0];
+        const int nj = j + delta[d][1];
+        open_door(std::min(i, ni), std::min(j, nj), delta[d][0] != 0);
+        visited[ni * rooms + nj] = 1;
+        stack.emplace_back(ni, nj);
+    }
+    for (int i = 0; i < rooms; i++) {
+        for (int j = 0; j < rooms; j++) {
+            if (i + 1 < rooms && extra(rng)) {
+                open_door(i, j, true);
+            }
+            if (j + 1 < rooms && extra(rng)) {
+                open_door(i, j, false);
+            }
+        }
+    }
+    return grid;
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef BOARD_IO_H
+#define BOARD_IO_H
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include "board.h"
+#include "mapped_file.h"
+
+/* BOARD FILE LOADING:
+ * ReadBoardFile() goes through getline(), an istringstream per line in
+ * ParseLine() and a copy of every row. On map files that are hundreds of MB
+ * that dominates startup. LoadBoardMmap() maps the file instead and parses the
+ * comma separated values straight into a Grid that is allocated up front:
+ *   1. count the cells in the first line and the number of lines (memchr)
+ *   2. allocate the Grid once
+ *   3. walk the mapping a single time, writing each cell in place
+ */
+
+// parses a .board file the same way as ParseLine() - every "<number>," is one
+// cell, 0 is kEmpty and anything else kObstacle. returns an empty Grid if the
+// file can't be read, the rows have different lengths or a number doesn't fit
+// in an int.
+Grid LoadBoardMmap( const std::string &path ) {
+    MappedFile file(path);
+    if (!file.IsOpen()) {
+        return Grid{};
+    }
+    file.AdviseSequential();
+    const char *begin = file.Data();
+    const char *end = begin + file.Size();
+
+    // 1. board dimensions
+    const char *first_eol = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+    const int cols = std::count(begin, first_eol ? first_eol : end, ',');
+    int rows = 0;
+    for (const char *p = begin; p < end; rows++) {
+        const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        p = eol ? eol + 1 : end;
+    }
+
+    // 2. one allocation for the whole board
+    Grid grid(rows, cols);
+
+    // 3. parse in place
+    const char *p = begin;
+    for (int x = 0; x < rows; x++) {
+        State *row = grid.Row(x);
+        int y = 0;
+        while (p < end && *p != '\n') {
+            int n = 0;
+            bool has_digits = false;
+            while (p < end && *p >= '0' && *p <= '9') {
+                if (n > (std::numeric_limits<int>::max() - (*p - '0')) / 10) {
+                    return Grid{};  // too many digits for an int
+                }
+                n = 10 * n + (*p - '0');
+                has_digits = true;
+                p++;
+            }
+            if (has_digits && p < end && *p == ',') {
+                if (y == cols) {
+                    return Grid{};
+                }
+                row[y++] = n == 0 ? State::kEmpty : State::kObstacle;
+                p++;
+            } else if (p < end && *p != '\n') {
+                // anything else (e.g. '\r' or a trailing value without a
+                // comma) ends the row, just like ParseLine()
+                const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+                p = eol ? eol : end;
+            }
+        }
+        if (y != cols) {
+            return Grid{};
+        }
+        p++;    // skip '\n'
+    }
+
+    return grid;
+}
+
+// writes the grid in the .board text format. kObstacle is written as 1 and
+// every other state as 0.
+bool WriteBoardFile( const Grid &grid, const std::string &path ) {
+    std::ofstream board_file(path);
+    if (!board_file) {
+        return false;
+    }
+    std::string line;
+    for (int x = 0; x < grid.Rows(); x++) {
+        line.clear();
+        const State *row = grid.Row(x);
+        for (int y = 0; y < grid.Cols(); y++) {
+            line += row[y] == State::kObstacle ? "1," : "0,";
+        }
+        line += '\n';
+        board_file << line;
+    }
+    return static_cast<bool>(board_file);
+}
+
+#endif
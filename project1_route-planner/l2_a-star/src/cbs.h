@@ -0,0 +1,630 @@
+#ifndef CBS_H
+#define CBS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "batch_planner.h"
+#include "board.h"
+#include "neighborhood.h"
+
+/* CONFLICT-BASED SEARCH (CBS):
+ * Sharon, Stern, Felner & Sturtevant. Paths for a fleet that never collide:
+ * every agent moves (or waits) one cell per time step, two agents may not be
+ * in the same cell at the same time (a vertex conflict) nor swap cells in one
+ * step (an edge conflict). Once an agent has arrived it stays on its goal.
+ *
+ * The high level searches a tree of constraints. The root plans every agent
+ * on its own; a node whose paths conflict is split in two, each child
+ * forbidding one of the two agents to be there (vertex) or to make that move
+ * (edge) at that time, and only that agent is planned again. Nodes are
+ * expanded cheapest first (sum of the arrival times), so the first node
+ * without a conflict is an optimal solution.
+ *
+ * The low level is A* in space-time, over (cell, t): the moves of the
+ * Neighborhood policy plus waiting, each one step. Its estimate is the number
+ * of steps to the goal without the other agents, from one BFS per goal - it
+ * knows the walls, unlike the Heuristic() of the policy, and it finds
+ * unreachable goals before any search. Among equally good paths it picks the
+ * one with the fewest conflicts with the paths of the other agents (a
+ * conflict avoidance table), which spares most of the splits that would
+ * otherwise be needed with dozens of agents.
+ *
+ * Two more things keep the tree small in crowded boards:
+ *   - bypass: a child whose new path is as cheap as the parent's and has
+ *     fewer conflicts replaces the split - it goes back on the open list
+ *     without a constraint, and its sibling is dropped.
+ *   - the conflict to split on is a cardinal one if there is any, one where
+ *     every path of both agents of the same length passes that cell at that
+ *     time (a level of width 1 of the agent's MDD), so both children cost
+ *     more and the lower bound goes up; then a semi-cardinal one.
+ *
+ * A node of the tree keeps only its new constraint and the new path of its
+ * agent; the rest is read off its ancestors. CBS can't tell that there is no
+ * solution at all, so Plan() gives up after max_nodes expansions.
+ */
+
+struct CbsResult {
+    bool found = false;
+    int cost = 0;                   // sum of the arrival times of all agents
+    int nodes = 0;                  // constraint tree nodes expanded
+    long long expansions = 0;       // (cell, t) states expanded by the low level
+};
+
+template <typename Neighborhood = FourConnected>
+class ConflictBasedSearch {
+  public:
+    static constexpr int kUnreachable = std::numeric_limits<int>::max();
+
+    explicit ConflictBasedSearch( int max_nodes = 100000 ) : max_nodes_(max_nodes) {}
+
+    /**
+     * One path per agent (agent i goes from queries[i].init to
+     * queries[i].goal): paths[i][t] is its cell at time t, and after the end
+     * of its path it waits on its goal. Returns false with no paths if an
+     * agent can't reach its goal, two agents share a start or a goal, or no
+     * solution turned up within max_nodes.
+     */
+    bool Plan( const GridView &board, const std::vector<Query> &queries,
+               std::vector<std::vector<Point>> &paths, CbsResult *result = nullptr ) {
+        CbsResult summary;
+        paths.clear();
+        board_ = &board;
+        queries_ = queries;
+        tree_.clear();
+        open_.clear();
+        occupants_[0].assign(board.Size(), Occupant{});
+        occupants_[1].assign(board.Size(), Occupant{});
+        stamp_ = 0;
+        marks_.assign(board.Size(), 0);
+        mark_ = 0;
+        expansions_ = 0;
+
+        bool valid = !board.Empty();
+        for (std::size_t i = 0; valid && i < queries.size(); i++) {
+            valid = FreeCell(queries[i].init) && FreeCell(queries[i].goal);
+            for (std::size_t j = 0; valid && j < i; j++) {
+                valid = queries[i].init != queries[j].init && queries[i].goal != queries[j].goal;
+            }
+        }
+        steps_to_goal_.resize(queries.size());
+        for (std::size_t i = 0; valid && i < queries.size(); i++) {
+            StepsToGoal(queries[i].goal, steps_to_goal_[i]);
+            valid = steps_to_goal_[i][Id(queries[i].init)] != kUnreachable;
+        }
+
+        // the root: every agent on its own, avoiding the ones planned before it
+        root_paths_.assign(queries.size(), std::vector<Point>{});
+        for (int agent = 0; valid && agent < static_cast<int>(queries.size()); agent++) {
+            constraints_.clear();
+            valid = PlanAgent(agent, root_paths_, agent, root_paths_[agent]);
+        }
+        if (valid) {
+            Node root;
+            for (const std::vector<Point> &path : root_paths_) {
+                root.cost += static_cast<int>(path.size()) - 1;
+            }
+            root.conflicts = CountConflicts(root_paths_, nullptr);
+            tree_.push_back(std::move(root));
+            Push(0);
+        }
+
+        while (!open_.empty() && summary.nodes < max_nodes_) {
+            const int current = Pop();
+            summary.nodes++;
+            Solution(current, solution_);
+            if (CountConflicts(solution_, &conflicts_) == 0) {
+                summary.found = true;
+                summary.cost = tree_[current].cost;
+                paths = solution_;
+                break;
+            }
+            const Conflict conflict = ChooseConflict(current);
+
+            // one child per agent of the conflict, each keeping that agent out of it
+            Node children[2];
+            bool planned[2]{false, false};
+            for (int side = 0; side < 2; side++) {
+                Node &child = children[side];
+                child.parent = current;
+                child.agent = conflict.agents[side];
+                child.constraint = Constraint{conflict.time, conflict.cells[side],
+                                              conflict.edge ? conflict.cells[1 - side] : -1};
+                Constraints(current, child.agent);
+                constraints_.push_back(child.constraint);
+                if (!PlanAgent(child.agent, solution_, queries_.size(), child.path)) {
+                    continue;
+                }
+                planned[side] = true;
+                child.cost = tree_[current].cost - static_cast<int>(solution_[child.agent].size()) +
+                             static_cast<int>(child.path.size());
+                std::swap(solution_[child.agent], child.path);
+                child.conflicts = CountConflicts(solution_, nullptr);
+                std::swap(solution_[child.agent], child.path);
+
+                // bypass: just as cheap and fewer conflicts - take the path, don't split
+                if (child.cost == tree_[current].cost &&
+                    child.conflicts < tree_[current].conflicts) {
+                    child.constraint.time = -1;
+                    tree_.push_back(std::move(child));
+                    Push(tree_.size() - 1);
+                    planned[0] = planned[1] = false;
+                    break;
+                }
+            }
+            for (int side = 0; side < 2; side++) {
+                if (planned[side]) {
+                    tree_.push_back(std::move(children[side]));
+                    Push(tree_.size() - 1);
+                }
+            }
+        }
+        summary.expansions = expansions_;
+        if (result) {
+            *result = summary;
+        }
+        return summary.found;
+    }
+
+  private:
+    // agent may not be in cell at time (from == -1), or may not move from
+    // from to cell arriving at time. a time of -1 constrains nothing
+    struct Constraint {
+        int time;
+        int cell;
+        int from;
+    };
+
+    struct Node {
+        int parent = -1;
+        int agent = -1;             // the agent planned again, -1 for the root
+        Constraint constraint{0, 0, -1};
+        std::vector<Point> path;    // the new path of agent
+        int cost = 0;               // sum of the arrival times
+        int conflicts = 0;
+    };
+
+    // agents[0] moves from cells[1] to cells[0] while agents[1] moves the other
+    // way (edge), or both are in cells[0] == cells[1] (vertex)
+    struct Conflict {
+        int agents[2];
+        int cells[2];
+        int time;
+        bool edge;
+    };
+
+    // a state of the low level; g is always the time
+    struct TimedCell {
+        int cell;
+        int time;
+        int h;
+        int conflicts;              // with the other agents on the way here
+        int parent;
+    };
+
+    struct Occupant {
+        std::uint32_t stamp = 0;
+        int agent = -1;
+    };
+
+    bool FreeCell( Point cell ) const {
+        return board_->InBounds(cell.x, cell.y) && (*board_)(cell.x, cell.y) != State::kObstacle;
+    }
+
+    int Id( Point cell ) const { return board_->Index(cell.x, cell.y); }
+
+    static Point At( const std::vector<Point> &path, int time ) {
+        return path[std::min<std::size_t>(time, path.size() - 1)];
+    }
+
+    std::uint64_t Key( int time, int cell ) const {
+        return std::uint64_t(time) * board_->Size() + cell;
+    }
+
+    std::uint64_t EdgeKey( int time, int from, int cell ) const {
+        return Key(time, from) * board_->Size() + cell;
+    }
+
+    // BFS back from goal, in steps
+    void StepsToGoal( Point goal, std::vector<int> &steps ) {
+        const GridView &board = *board_;
+        steps.assign(board.Size(), kUnreachable);
+        queue_.assign(1, Id(goal));
+        steps[Id(goal)] = 0;
+        for (std::size_t head = 0; head < queue_.size(); head++) {
+            const int id = queue_[head];
+            const int x = board.IndexX(id);
+            const int y = board.IndexY(id);
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int next_x = x + Neighborhood::kDelta[i][0];
+                const int next_y = y + Neighborhood::kDelta[i][1];
+                if (board.InBounds(next_x, next_y) && board(next_x, next_y) != State::kObstacle &&
+                    Neighborhood::CanMove(board, x, y, i) &&
+                    steps[board.Index(next_x, next_y)] == kUnreachable) {
+                    steps[board.Index(next_x, next_y)] = steps[id] + 1;
+                    queue_.push_back(board.Index(next_x, next_y));
+                }
+            }
+        }
+    }
+
+    // the constraints of agent on the way from the root to node
+    void Constraints( int node, int agent ) {
+        constraints_.clear();
+        for (; node > 0; node = tree_[node].parent) {
+            if (tree_[node].agent == agent && tree_[node].constraint.time >= 0) {
+                constraints_.push_back(tree_[node].constraint);
+            }
+        }
+    }
+
+    // constraints_ as look-up sets; returns the last time agent is kept off its goal
+    int LoadConstraints( int agent ) {
+        const int goal = Id(queries_[agent].goal);
+        vertex_constraints_.clear();
+        edge_constraints_.clear();
+        int last_goal_constraint = -1;
+        for (const Constraint &constraint : constraints_) {
+            if (constraint.from < 0) {
+                vertex_constraints_.insert(Key(constraint.time, constraint.cell));
+                if (constraint.cell == goal) {
+                    last_goal_constraint = std::max(last_goal_constraint, constraint.time);
+                }
+            } else {
+                edge_constraints_.insert(EdgeKey(constraint.time, constraint.from, constraint.cell));
+            }
+        }
+        return last_goal_constraint;
+    }
+
+    // calls visit(next) for waiting in cell and every move out of it onto a free cell
+    template <typename Visit>
+    void ForEachStep( int cell, Visit visit ) const {
+        const GridView &board = *board_;
+        const int x = board.IndexX(cell);
+        const int y = board.IndexY(cell);
+        visit(cell);
+        for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+            const int next_x = x + Neighborhood::kDelta[i][0];
+            const int next_y = y + Neighborhood::kDelta[i][1];
+            if (board.InBounds(next_x, next_y) && board(next_x, next_y) != State::kObstacle &&
+                Neighborhood::CanMove(board, x, y, i)) {
+                visit(board.Index(next_x, next_y));
+            }
+        }
+    }
+
+    bool Allowed( int time, int from, int cell ) const {
+        return !vertex_constraints_.count(Key(time, cell)) &&
+               !edge_constraints_.count(EdgeKey(time, from, cell));
+    }
+
+    /**
+     * For every time step of path, the one cell that all of agent's paths
+     * of the same length (under its constraints at node) pass at that time,
+     * -1 where there are several: the levels of width 1 of its MDD
+     * (multi-valued decision diagram).
+     */
+    void Bottlenecks( int node, int agent, const std::vector<Point> &path, std::vector<int> &cells ) {
+        Constraints(node, agent);
+        LoadConstraints(agent);
+        const std::vector<int> &steps = steps_to_goal_[agent];
+        const int arrival = static_cast<int>(path.size()) - 1;
+
+        // forward: where agent can be at each time and still make it in time
+        levels_.resize(arrival + 1);
+        levels_[0].assign(1, Id(queries_[agent].init));
+        for (int time = 1; time <= arrival; time++) {
+            levels_[time].clear();
+            const std::uint32_t stamp = NextMark();
+            for (const int cell : levels_[time - 1]) {
+                ForEachStep(cell, [&](int next) {
+                    if (marks_[next] != stamp && steps[next] <= arrival - time &&
+                        Allowed(time, cell, next)) {
+                        marks_[next] = stamp;
+                        levels_[time].push_back(next);
+                    }
+                });
+            }
+        }
+        // backward: only the cells from which the goal is reached at arrival
+        cells.assign(arrival + 1, -1);
+        levels_[arrival].assign(1, Id(queries_[agent].goal));
+        cells[arrival] = levels_[arrival][0];
+        for (int time = arrival - 1; time >= 0; time--) {
+            const std::uint32_t stamp = NextMark();
+            for (const int cell : levels_[time + 1]) {
+                marks_[cell] = stamp;
+            }
+            std::vector<int> &level = levels_[time];
+            level.erase(std::remove_if(level.begin(), level.end(), [&](int cell) {
+                bool onward = false;
+                ForEachStep(cell, [&](int next) {
+                    onward = onward || (marks_[next] == stamp && Allowed(time + 1, cell, next));
+                });
+                return !onward;
+            }), level.end());
+            cells[time] = level.size() == 1 ? level[0] : -1;
+        }
+    }
+
+    std::uint32_t NextMark() {
+        if (mark_ == std::numeric_limits<std::uint32_t>::max()) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            mark_ = 0;
+        }
+        return ++mark_;
+    }
+
+    // whether agent can't get out of the conflict without arriving later
+    bool Cardinal( int node, int agent, const Conflict &conflict, int side ) {
+        const std::vector<Point> &path = solution_[agent];
+        if (conflict.time >= static_cast<int>(path.size())) {
+            return true; // it already waits on its goal, it has to come later
+        }
+        if (!bottlenecks_ready_[agent]) {
+            Bottlenecks(node, agent, path, bottlenecks_[agent]);
+            bottlenecks_ready_[agent] = true;
+        }
+        const std::vector<int> &cells = bottlenecks_[agent];
+        if (cells[conflict.time] != conflict.cells[side]) {
+            return false;
+        }
+        return !conflict.edge || cells[conflict.time - 1] == conflict.cells[1 - side];
+    }
+
+    /**
+     * The conflict of conflicts_ to split node on: the first cardinal one
+     * (both agents get more expensive, so both children cost more), else the
+     * first semi-cardinal one, else the first one.
+     */
+    Conflict ChooseConflict( int node ) {
+        bottlenecks_ready_.assign(queries_.size(), false);
+        bottlenecks_.resize(queries_.size());
+        int best = 0;
+        int best_kind = -1;
+        for (int i = 0; i < static_cast<int>(conflicts_.size()) && best_kind < 2; i++) {
+            const Conflict &conflict = conflicts_[i];
+            const int kind = Cardinal(node, conflict.agents[0], conflict, 0) +
+                             Cardinal(node, conflict.agents[1], conflict, 1);
+            if (kind > best_kind) {
+                best = i;
+                best_kind = kind;
+            }
+        }
+        return conflicts_[best];
+    }
+
+    // the paths of node: the root's, replaced by the newest path of every agent on the way
+    void Solution( int node, std::vector<std::vector<Point>> &paths ) {
+        paths = root_paths_;
+        replaced_.assign(paths.size(), false);
+        for (; node > 0; node = tree_[node].parent) {
+            const int agent = tree_[node].agent;
+            if (!replaced_[agent]) {
+                paths[agent] = tree_[node].path;
+                replaced_[agent] = true;
+            }
+        }
+    }
+
+    /**
+     * Counts the conflicts between the paths (an agent meeting another one
+     * counts once per time step) and lists them in all, earliest first.
+     */
+    int CountConflicts( const std::vector<std::vector<Point>> &paths, std::vector<Conflict> *all ) {
+        if (all) {
+            all->clear();
+        }
+        std::size_t horizon = 0;
+        for (const std::vector<Point> &path : paths) {
+            horizon = std::max(horizon, path.size());
+        }
+        int count = 0;
+        for (int time = 0; time < static_cast<int>(horizon); time++) {
+            if (stamp_ == std::numeric_limits<std::uint32_t>::max()) {
+                for (std::vector<Occupant> &occupants : occupants_) {
+                    std::fill(occupants.begin(), occupants.end(), Occupant{});
+                }
+                stamp_ = 0;
+            }
+            const std::uint32_t stamp = ++stamp_;
+            std::vector<Occupant> &now = occupants_[time & 1];
+            const std::vector<Occupant> &before = occupants_[(time + 1) & 1];
+            for (int agent = 0; agent < static_cast<int>(paths.size()); agent++) {
+                const int cell = Id(At(paths[agent], time));
+                if (now[cell].stamp == stamp) {
+                    count++;
+                    if (all) {
+                        all->push_back(Conflict{{now[cell].agent, agent}, {cell, cell}, time, false});
+                    }
+                } else {
+                    now[cell] = Occupant{stamp, agent};
+                }
+                if (time == 0) {
+                    continue;
+                }
+                // swapped with whoever was on our cell a step ago (found from the higher agent)
+                const int from = Id(At(paths[agent], time - 1));
+                const int other = before[cell].stamp == stamp - 1 ? before[cell].agent : -1;
+                if (from != cell && other >= 0 && other < agent &&
+                    Id(At(paths[other], time)) == from) {
+                    count++;
+                    if (all) {
+                        all->push_back(Conflict{{agent, other}, {cell, from}, time, true});
+                    }
+                }
+            }
+        }
+        return count;
+    }
+
+    // whether a state comes off the open list after another: f, then fewer
+    // conflicts, then closer to the goal
+    bool Later( int a, int b ) const {
+        const TimedCell &s = states_[a];
+        const TimedCell &t = states_[b];
+        const int f_a = s.time + s.h;
+        const int f_b = t.time + t.h;
+        if (f_a != f_b) {
+            return f_a > f_b;
+        }
+        if (s.conflicts != t.conflicts) {
+            return s.conflicts > t.conflicts;
+        }
+        return s.h > t.h;
+    }
+
+    /**
+     * Space-time A* for agent under constraints_. The other agents of paths
+     * (all but agent, and only those below `planned`) are the conflict
+     * avoidance table. Fills path, returns false if there is none.
+     */
+    bool PlanAgent( int agent, const std::vector<std::vector<Point>> &paths, int planned,
+                    std::vector<Point> &path ) {
+        const GridView &board = *board_;
+        const std::vector<int> &steps = steps_to_goal_[agent];
+        const int goal = Id(queries_[agent].goal);
+
+        const int last_goal_constraint = LoadConstraints(agent);
+        int last_constraint = 0;
+        for (const Constraint &constraint : constraints_) {
+            last_constraint = std::max(last_constraint, constraint.time);
+        }
+        // once the constraints are over, any detour is shorter than a lap of the board
+        const int horizon = last_constraint + board.Size();
+
+        occupied_.clear();
+        parked_.clear();
+        for (int other = 0; other < planned && other < static_cast<int>(paths.size()); other++) {
+            if (other == agent || paths[other].empty()) {
+                continue;
+            }
+            for (int time = 0; time < static_cast<int>(paths[other].size()); time++) {
+                occupied_.insert(Key(time, Id(paths[other][time])));
+            }
+            parked_.push_back({Id(paths[other].back()), int(paths[other].size()) - 1});
+        }
+        auto conflicts_at = [&](int cell, int time) {
+            int count = occupied_.count(Key(time, cell));
+            for (const std::pair<int, int> &park : parked_) {
+                count += park.first == cell && time > park.second;
+            }
+            return count;
+        };
+
+        states_.clear();
+        heap_.clear();
+        closed_.clear();
+        const int start = Id(queries_[agent].init);
+        states_.push_back(TimedCell{start, 0, steps[start], 0, -1});
+        heap_.push_back(0);
+        auto later = [this](int a, int b) { return Later(a, b); };
+        while (!heap_.empty()) {
+            std::pop_heap(heap_.begin(), heap_.end(), later);
+            const int current = heap_.back();
+            heap_.pop_back();
+            const TimedCell state = states_[current];
+            if (!closed_.insert(Key(state.time, state.cell)).second) {
+                continue;
+            }
+            expansions_++;
+            if (state.cell == goal && state.time > last_goal_constraint) {
+                path.clear();
+                for (int id = current; id != -1; id = states_[id].parent) {
+                    path.push_back(Point{board.IndexX(states_[id].cell), board.IndexY(states_[id].cell)});
+                }
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+            if (state.time >= horizon) {
+                continue;
+            }
+
+            // the moves of the policy, then waiting in place
+            const int x = board.IndexX(state.cell);
+            const int y = board.IndexY(state.cell);
+            const int time = state.time + 1;
+            for (int i = 0; i <= Neighborhood::kNeighbors; i++) {
+                int next = state.cell;
+                if (i < Neighborhood::kNeighbors) {
+                    const int next_x = x + Neighborhood::kDelta[i][0];
+                    const int next_y = y + Neighborhood::kDelta[i][1];
+                    if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                        !Neighborhood::CanMove(board, x, y, i)) {
+                        continue;
+                    }
+                    next = board.Index(next_x, next_y);
+                }
+                if (vertex_constraints_.count(Key(time, next)) ||
+                    edge_constraints_.count(EdgeKey(time, state.cell, next)) ||
+                    closed_.count(Key(time, next))) {
+                    continue;
+                }
+                states_.push_back(TimedCell{next, time, steps[next],
+                                        state.conflicts + conflicts_at(next, time), current});
+                heap_.push_back(states_.size() - 1);
+                std::push_heap(heap_.begin(), heap_.end(), later);
+            }
+        }
+        return false;
+    }
+
+    void Push( int node ) {
+        open_.push_back(node);
+        std::push_heap(open_.begin(), open_.end(), [this](int a, int b) { return After(a, b); });
+    }
+
+    int Pop() {
+        std::pop_heap(open_.begin(), open_.end(), [this](int a, int b) { return After(a, b); });
+        const int node = open_.back();
+        open_.pop_back();
+        return node;
+    }
+
+    // whether tree node a is expanded after b: cost, then fewer conflicts
+    bool After( int a, int b ) const {
+        if (tree_[a].cost != tree_[b].cost) {
+            return tree_[a].cost > tree_[b].cost;
+        }
+        return tree_[a].conflicts > tree_[b].conflicts;
+    }
+
+    int max_nodes_;
+
+    // the current Plan()
+    const GridView *board_ = nullptr;
+    std::vector<Query> queries_;
+    std::vector<std::vector<int>> steps_to_goal_;   // per agent, per cell
+    std::vector<std::vector<Point>> root_paths_;
+    std::vector<Node> tree_;
+    std::vector<int> open_;                         // heap of tree nodes
+    std::vector<std::vector<Point>> solution_;      // paths of the node being expanded
+    std::vector<bool> replaced_;
+    std::vector<Occupant> occupants_[2];            // per cell, at even / odd times
+    std::uint32_t stamp_ = 0;
+    std::vector<int> queue_;
+    std::vector<Conflict> conflicts_;               // of the node being expanded
+    std::vector<std::vector<int>> bottlenecks_;     // per agent, see Bottlenecks()
+    std::vector<bool> bottlenecks_ready_;
+    std::vector<std::vector<int>> levels_;          // of the MDD being built
+    std::vector<std::uint32_t> marks_;              // per cell
+    std::uint32_t mark_ = 0;
+
+    // the low level
+    std::vector<Constraint> constraints_;
+    std::unordered_set<std::uint64_t> vertex_constraints_;
+    std::unordered_set<std::uint64_t> edge_constraints_;
+    std::unordered_set<std::uint64_t> occupied_;    // (time, cell) of the other agents
+    std::vector<std::pair<int, int>> parked_;       // (goal, arrival) of the other agents
+    std::vector<TimedCell> states_;
+    std::vector<int> heap_;
+    std::unordered_set<std::uint64_t> closed_;
+    long long expansions_ = 0;
+};
+
+#endif
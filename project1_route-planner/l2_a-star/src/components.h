@@ -0,0 +1,349 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+#include "search_context.h"
+
+/* CONNECTED COMPONENTS:
+ * A search for a goal it can't reach only gives up after it has expanded every
+ * cell it can reach - the most expensive query there is. A ComponentIndex
+ * labels every free cell with the component it belongs to (under the moves of
+ * the Neighborhood policy), so Connected() answers "is there a path at all" by
+ * comparing two labels, before any search starts.
+ *
+ * Build() labels the board with one flood fill per component. After that the
+ * index follows single cell flips with Update():
+ *   - a cell becomes free: it joins the components of its neighbors. The
+ *     smaller ones are relabeled to the largest, so every cell only changes
+ *     its label when its component at least doubles in size.
+ *   - a cell becomes blocked: if the free cells around it are still connected
+ *     within the 3x3 block, nothing can have split. Otherwise one BFS per
+ *     piece runs in lockstep, merging when they meet; every piece that runs
+ *     dry is a component of its own and gets a new label. The last piece still
+ *     going keeps the old label, so a split costs about the size of the
+ *     pieces that broke off, not of the whole component.
+ */
+template <typename Neighborhood = FourConnected>
+class ComponentIndex {
+  public:
+    static constexpr int kNone = -1;    // label of a blocked cell
+
+    ComponentIndex() = default;
+    explicit ComponentIndex( const GridView &board ) { Build(board); }
+
+    void Build( const GridView &board ) {
+        rows_ = board.Rows();
+        cols_ = board.Cols();
+        labels_.assign(std::size_t(rows_) * cols_, kNone);
+        sizes_.clear();
+        free_labels_.clear();
+        marks_.assign(labels_.size(), 0);
+        stamp_ = 0;
+        for (int id = 0; id < static_cast<int>(labels_.size()); id++) {
+            if (labels_[id] == kNone && board(id / cols_, id % cols_) != State::kObstacle) {
+                const int label = NewLabel();
+                labels_[id] = label;
+                sizes_[label] = 1 + Relabel(board, id, kNone, label);
+            }
+        }
+    }
+
+    int Label( int x, int y ) const { return labels_[std::size_t(x) * cols_ + y]; }
+
+    // number of components
+    int Count() const { return sizes_.size() - free_labels_.size(); }
+
+    // cells in the component of (x, y), 0 for a blocked cell
+    int ComponentSize( int x, int y ) const {
+        const int label = Label(x, y);
+        return label == kNone ? 0 : sizes_[label];
+    }
+
+    // true if there is a path from a to b; false if either is off the board or blocked
+    bool Connected( Point a, Point b ) const {
+        if (a.x < 0 || a.x >= rows_ || a.y < 0 || a.y >= cols_ ||
+            b.x < 0 || b.x >= rows_ || b.y < 0 || b.y >= cols_) {
+            return false;
+        }
+        const int label = Label(a.x, a.y);
+        return label != kNone && label == Label(b.x, b.y);
+    }
+
+    /**
+     * Catches up with one cell of the board that was flipped between free and
+     * blocked. Call it once per flip, right after it: the index has to be in
+     * sync with every other cell of the board.
+     */
+    void Update( const GridView &board, Point cell ) {
+        const int id = cell.x * cols_ + cell.y;
+        const bool blocked = board(cell.x, cell.y) == State::kObstacle;
+        if (blocked == (labels_[id] == kNone)) {
+            return;
+        }
+        if (blocked) {
+            Split(board, cell);
+        } else {
+            Join(board, cell);
+        }
+    }
+
+  private:
+    // one BFS of a split
+    struct Piece {
+        std::vector<int> cells;     // visited, in BFS order - the queue is cells[head..]
+        std::size_t head = 0;
+        int merged_into = -1;       // piece that took over the queue when they met
+        bool done = false;          // the queue ran dry
+    };
+
+    int NewLabel() {
+        if (!free_labels_.empty()) {
+            const int label = free_labels_.back();
+            free_labels_.pop_back();
+            return label;
+        }
+        sizes_.push_back(0);
+        return sizes_.size() - 1;
+    }
+
+    void FreeLabel( int label ) {
+        sizes_[label] = 0;
+        free_labels_.push_back(label);
+    }
+
+    // calls visit(next id) for every move out of cell id onto a free cell
+    template <typename Visit>
+    void ForEachMove( const GridView &board, int id, Visit visit ) const {
+        const int x = id / cols_;
+        const int y = id % cols_;
+        for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+            const int next_x = x + Neighborhood::kDelta[i][0];
+            const int next_y = y + Neighborhood::kDelta[i][1];
+            if (board.InBounds(next_x, next_y) && board(next_x, next_y) != State::kObstacle &&
+                Neighborhood::CanMove(board, x, y, i)) {
+                visit(next_x * cols_ + next_y);
+            }
+        }
+    }
+
+    // floods the cells labeled from that are connected to start with to
+    // (start itself excluded), returns how many there were
+    int Relabel( const GridView &board, int start, int from, int to ) {
+        queue_.assign(1, start);
+        for (std::size_t head = 0; head < queue_.size(); head++) {
+            ForEachMove(board, queue_[head], [&](int next) {
+                if (labels_[next] == from) {
+                    labels_[next] = to;
+                    queue_.push_back(next);
+                }
+            });
+        }
+        return queue_.size() - 1;
+    }
+
+    void Join( const GridView &board, Point cell ) {
+        const int id = cell.x * cols_ + cell.y;
+        int joined[Neighborhood::kNeighbors];
+        int count = 0;
+        int largest = kNone;
+        ForEachMove(board, id, [&](int next) {
+            const int label = labels_[next];
+            if (label != kNone && std::find(joined, joined + count, label) == joined + count) {
+                joined[count++] = label;
+                if (largest == kNone || sizes_[label] > sizes_[largest]) {
+                    largest = label;
+                }
+            }
+        });
+        if (largest == kNone) {
+            largest = NewLabel();
+        }
+        labels_[id] = largest;
+        sizes_[largest]++;
+        for (int i = 0; i < count; i++) {
+            if (joined[i] != largest) {
+                sizes_[largest] += sizes_[joined[i]];
+                FreeLabel(joined[i]);
+                Relabel(board, id, joined[i], largest);
+            }
+        }
+    }
+
+    void Split( const GridView &board, Point cell ) {
+        const int id = cell.x * cols_ + cell.y;
+        const int label = labels_[id];
+        labels_[id] = kNone;
+        if (--sizes_[label] == 0) {
+            FreeLabel(label);
+            return;
+        }
+
+        // the free cells of the old component around cell, grouped by the
+        // moves between them that are left
+        int ring[8];
+        int group[8];
+        int count = 0;
+        for (int i = 0; i < EightConnected::kNeighbors; i++) {
+            const int x = cell.x + EightConnected::kDelta[i][0];
+            const int y = cell.y + EightConnected::kDelta[i][1];
+            if (board.InBounds(x, y) && labels_[x * cols_ + y] == label) {
+                group[count] = count;
+                ring[count++] = x * cols_ + y;
+            }
+        }
+        auto find = [&group](int i) {
+            while (group[i] != i) {
+                i = group[i];
+            }
+            return i;
+        };
+        for (int i = 0; i < count; i++) {
+            ForEachMove(board, ring[i], [&](int next) {
+                const int j = std::find(ring, ring + count, next) - ring;
+                if (j < count) {
+                    group[find(j)] = find(i);
+                }
+            });
+        }
+        int seeds[8];
+        int pieces = 0;
+        for (int i = 0; i < count; i++) {
+            if (find(i) == i) {
+                seeds[pieces++] = ring[i];
+            }
+        }
+        if (pieces > 1) {
+            Race(board, label, seeds, pieces);
+        }
+    }
+
+    // one BFS per seed in lockstep, see the comment at the top
+    void Race( const GridView &board, int label, const int *seeds, int pieces ) {
+        if (stamp_ > std::numeric_limits<std::uint32_t>::max() - 16) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            stamp_ = 0;
+        }
+        const std::uint32_t base = stamp_ + 1;
+        stamp_ += 8;
+
+        pieces_.resize(std::max<std::size_t>(pieces_.size(), pieces));
+        for (int s = 0; s < pieces; s++) {
+            pieces_[s].cells.assign(1, seeds[s]);
+            pieces_[s].head = 0;
+            pieces_[s].merged_into = -1;
+            pieces_[s].done = false;
+            marks_[seeds[s]] = base + s;
+        }
+        auto owner = [&](int s) {
+            while (pieces_[s].merged_into >= 0) {
+                s = pieces_[s].merged_into;
+            }
+            return s;
+        };
+
+        int running = pieces;
+        while (running > 1) {
+            for (int s = 0; s < pieces && running > 1; s++) {
+                Piece &piece = pieces_[s];
+                if (piece.merged_into >= 0 || piece.done) {
+                    continue;
+                }
+                if (piece.head == piece.cells.size()) {
+                    piece.done = true;
+                    running--;
+                    continue;
+                }
+                const int current = piece.cells[piece.head++];
+                ForEachMove(board, current, [&](int next) {
+                    if (labels_[next] != label) {
+                        return;
+                    }
+                    if (marks_[next] < base || marks_[next] >= base + 8) {
+                        marks_[next] = base + s;
+                        piece.cells.push_back(next);
+                        return;
+                    }
+                    // met another piece: it's the same component, take over its queue
+                    const int other = owner(marks_[next] - base);
+                    if (other != s) {
+                        Piece &absorbed = pieces_[other];
+                        piece.cells.insert(piece.cells.end(), absorbed.cells.begin() + absorbed.head,
+                                           absorbed.cells.end());
+                        absorbed.cells.resize(absorbed.head);
+                        absorbed.merged_into = s;
+                        running--;
+                    }
+                });
+            }
+        }
+
+        // every piece that ran dry is a component of its own
+        for (int s = 0; s < pieces; s++) {
+            if (!pieces_[s].done) {
+                continue;
+            }
+            const int new_label = NewLabel();
+            for (int t = 0; t < pieces; t++) {
+                if (owner(t) == s) {
+                    for (int cell : pieces_[t].cells) {
+                        labels_[cell] = new_label;
+                    }
+                    sizes_[new_label] += pieces_[t].cells.size();
+                }
+            }
+            sizes_[label] -= sizes_[new_label];
+        }
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    std::vector<int> labels_;           // per cell, x * cols + y
+    std::vector<int> sizes_;            // per label, 0 for unused labels
+    std::vector<int> free_labels_;
+    std::vector<int> queue_;
+    std::vector<std::uint32_t> marks_;  // base + piece of the split that visited a cell
+    std::uint32_t stamp_ = 0;
+    std::vector<Piece> pieces_;         // of the current split
+};
+
+/**
+ * Search() that asks the index first: when init and goal are in different
+ * components (or either is blocked) it reports "No path found!" right away,
+ * without expanding a single cell.
+ */
+template <typename Neighborhood = FourConnected>
+Grid Search( const Grid &grid, const ComponentIndex<Neighborhood> &components,
+             int init[2], int goal[2], SearchContext &context, SearchResult *result = nullptr ) {
+    if (!components.Connected(Point{init[0], init[1]}, Point{goal[0], goal[1]})) {
+        if (result) {
+            *result = SearchResult{};
+        }
+        cout << "No path found!" << "\n";
+        return Grid{};
+    }
+    return Search<Neighborhood>(grid, init, goal, context, result);
+}
+
+// FindPath() that returns false right away for an unreachable goal
+template <typename Neighborhood = FourConnected, typename CellCost = UniformCost>
+bool FindPath( const GridView &board, const ComponentIndex<Neighborhood> &components,
+               Point init, Point goal, SearchContext &context, vector<Point> &path,
+               SearchResult *result = nullptr, const CellCost &cell_cost = CellCost{} ) {
+    if (!components.Connected(init, goal)) {
+        path.clear();
+        if (result) {
+            *result = SearchResult{};
+        }
+        return false;
+    }
+    return FindPath<Neighborhood>(board, init, goal, context, path, result, cell_cost);
+}
+
+#endif
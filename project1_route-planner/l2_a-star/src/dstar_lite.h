@@ -0,0 +1,273 @@
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+#include "open_list.h"
+
+/* D* LITE:
+ * Incremental replanning (Koenig & Likhachev). The search runs backwards, from
+ * goal towards start, and keeps two estimates per cell:
+ *   g(s)   - the cost-to-goal the last expansion of s settled on
+ *   rhs(s) - the one-step lookahead min over successors s' of c(s, s') + g(s')
+ * A cell with g != rhs is "inconsistent" and sits on the open list. Once
+ * start is consistent and nothing on the open list has a smaller key, g(start)
+ * is the optimal cost.
+ *
+ * When cells change, only the rhs-values of the changed cells and their
+ * neighbors are recomputed; the ones that became inconsistent go back on the
+ * open list, and the next ComputeShortestPath() repairs outward from there -
+ * usually a small region around the change instead of the whole board. Moving
+ * the start (the robot drives along the path) is handled with the key
+ * modifier km instead of re-keying the open list.
+ *
+ * Keys are (k1, k2) = (min(g, rhs) + h(start, s) + km, min(g, rhs)), compared
+ * lexicographically. The planner owns its copy of the board.
+ */
+
+// a cell that becomes kObstacle, or free again (any other State)
+struct CellChange {
+    Point cell;
+    State state;
+};
+
+struct DStarKey {
+    int k1;
+    int k2;
+};
+
+inline bool operator<( const DStarKey &a, const DStarKey &b ) {
+    return a.k1 < b.k1 || (a.k1 == b.k1 && a.k2 < b.k2);
+}
+
+template <typename Neighborhood = FourConnected>
+class DStarLite {
+  public:
+    // small enough that kInfinity + heuristic + km can't overflow
+    static constexpr int kInfinity = std::numeric_limits<int>::max() / 4;
+
+    // plans from scratch on a copy of board. with start or goal off the board
+    // or blocked, there is nothing to plan on until the next Plan()
+    bool Plan( const GridView &board, Point start, Point goal, SearchResult *result = nullptr ) {
+        const bool valid = !board.Empty() && board.InBounds(start.x, start.y) &&
+                           board.InBounds(goal.x, goal.y) &&
+                           board(start.x, start.y) != State::kObstacle &&
+                           board(goal.x, goal.y) != State::kObstacle;
+        board_ = valid ? Grid(board) : Grid{};
+        g_vals_.assign(board_.Size(), kInfinity);
+        rhs_vals_.assign(board_.Size(), kInfinity);
+        open_list_.Reset(board_.Size());
+        km_ = 0;
+        if (!valid) {
+            if (result) {
+                *result = SearchResult{};
+            }
+            return false;
+        }
+        start_ = start;
+        last_ = start;
+        goal_ = goal;
+        const int goal_id = board_.Index(goal.x, goal.y);
+        rhs_vals_[goal_id] = 0;
+        open_list_.Push(goal_id, CalculateKey(goal_id));
+        return ComputeShortestPath(result);
+    }
+
+    /**
+     * Applies a batch of cell changes and repairs the solution. Changes that
+     * don't flip a cell between free and blocked are ignored.
+     */
+    bool UpdateCells( const std::vector<CellChange> &changes, SearchResult *result = nullptr ) {
+        for (const CellChange &change : changes) {
+            const Point p = change.cell;
+            if (!board_.InBounds(p.x, p.y)) {
+                continue;
+            }
+            const bool blocked = change.state == State::kObstacle;
+            if ((board_(p.x, p.y) == State::kObstacle) == blocked) {
+                continue;
+            }
+            board_(p.x, p.y) = blocked ? State::kObstacle : State::kEmpty;
+
+            // edges into and out of p changed cost, and so did the diagonals
+            // that pass p when corners can't be cut - all of them start at p
+            // or at one of its 8 neighbors
+            UpdateVertex(board_.Index(p.x, p.y));
+            for (int i = 0; i < EightConnected::kNeighbors; i++) {
+                const int x = p.x + EightConnected::kDelta[i][0];
+                const int y = p.y + EightConnected::kDelta[i][1];
+                if (board_.InBounds(x, y)) {
+                    UpdateVertex(board_.Index(x, y));
+                }
+            }
+        }
+        return ComputeShortestPath(result);
+    }
+
+    // the robot moved to start, e.g. along Path(). false, and nothing
+    // changes, if start is off the board or blocked
+    bool MoveStart( Point start, SearchResult *result = nullptr ) {
+        if (!board_.InBounds(start.x, start.y) || board_(start.x, start.y) == State::kObstacle) {
+            if (result) {
+                *result = SearchResult{};
+            }
+            return false;
+        }
+        km_ += Neighborhood::Heuristic(last_.x, last_.y, start.x, start.y);
+        last_ = start;
+        start_ = start;
+        return ComputeShortestPath(result);
+    }
+
+    bool Found() const { return board_.InBounds(start_.x, start_.y) && Cost() < kInfinity; }
+    int Cost() const { return g_vals_[board_.Index(start_.x, start_.y)]; }
+    const Grid &Board() const { return board_; }
+
+    // the current best path from start to goal, empty if there is none
+    std::vector<Point> Path() const {
+        std::vector<Point> path;
+        if (!Found()) {
+            return path;
+        }
+        Point at = start_;
+        path.push_back(at);
+        while (at != goal_ && static_cast<int>(path.size()) <= board_.Size()) {
+            // step to the successor that the g-values say is on the way
+            int best = kInfinity;
+            Point next = at;
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int cost = EdgeCost(at.x, at.y, i);
+                if (cost == kInfinity) {
+                    continue;
+                }
+                const int x = at.x + Neighborhood::kDelta[i][0];
+                const int y = at.y + Neighborhood::kDelta[i][1];
+                const int g = g_vals_[board_.Index(x, y)];
+                if (g < kInfinity && cost + g < best) {
+                    best = cost + g;
+                    next = Point{x, y};
+                }
+            }
+            if (next == at) {
+                return {};
+            }
+            at = next;
+            path.push_back(at);
+        }
+        return path;
+    }
+
+  private:
+    int H( int id ) const {
+        return Neighborhood::Heuristic(start_.x, start_.y, board_.IndexX(id), board_.IndexY(id));
+    }
+
+    DStarKey CalculateKey( int id ) const {
+        const int k2 = std::min(g_vals_[id], rhs_vals_[id]);
+        return DStarKey{k2 + H(id) + km_, k2};
+    }
+
+    // cost of move i out of (x, y), kInfinity if it's off the board or blocked
+    int EdgeCost( int x, int y, int i ) const {
+        const int to_x = x + Neighborhood::kDelta[i][0];
+        const int to_y = y + Neighborhood::kDelta[i][1];
+        if (!board_.InBounds(to_x, to_y) || board_(x, y) == State::kObstacle ||
+            board_(to_x, to_y) == State::kObstacle ||
+            !Neighborhood::CanMove(board_, x, y, i)) {
+            return kInfinity;
+        }
+        return Neighborhood::kCost[i];
+    }
+
+    void UpdateVertex( int id ) {
+        const int x = board_.IndexX(id);
+        const int y = board_.IndexY(id);
+        if (Point{x, y} != goal_) {
+            int rhs = kInfinity;
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int cost = EdgeCost(x, y, i);
+                if (cost == kInfinity) {
+                    continue;
+                }
+                const int g = g_vals_[board_.Index(x + Neighborhood::kDelta[i][0],
+                                                   y + Neighborhood::kDelta[i][1])];
+                rhs = std::min(rhs, g == kInfinity ? kInfinity : cost + g);
+            }
+            rhs_vals_[id] = rhs;
+        }
+        if (g_vals_[id] != rhs_vals_[id]) {
+            if (open_list_.Contains(id)) {
+                open_list_.Update(id, CalculateKey(id));
+            } else {
+                open_list_.Push(id, CalculateKey(id));
+            }
+        } else if (open_list_.Contains(id)) {
+            open_list_.Remove(id);
+        }
+    }
+
+    // the graph is undirected, so the predecessors are the neighbors as well
+    void UpdateNeighbors( int id ) {
+        const int x = board_.IndexX(id);
+        const int y = board_.IndexY(id);
+        for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+            const int nx = x + Neighborhood::kDelta[i][0];
+            const int ny = y + Neighborhood::kDelta[i][1];
+            if (board_.InBounds(nx, ny)) {
+                UpdateVertex(board_.Index(nx, ny));
+            }
+        }
+    }
+
+    bool ComputeShortestPath( SearchResult *result ) {
+        SearchResult summary;
+        if (!board_.InBounds(start_.x, start_.y)) {
+            if (result) {
+                *result = summary;
+            }
+            return false;
+        }
+        const int start_id = board_.Index(start_.x, start_.y);
+        while (!open_list_.Empty() && (open_list_.Top().key < CalculateKey(start_id) ||
+                                       rhs_vals_[start_id] != g_vals_[start_id])) {
+            const auto [id, old_key] = open_list_.Pop();
+            summary.expansions++;
+            const DStarKey new_key = CalculateKey(id);
+            if (old_key < new_key) {
+                // km went up since id was queued
+                open_list_.Push(id, new_key);
+            } else if (g_vals_[id] > rhs_vals_[id]) {
+                // overconsistent: settle g, neighbors may get cheaper
+                g_vals_[id] = rhs_vals_[id];
+                UpdateNeighbors(id);
+            } else {
+                // underconsistent: the old g is gone, re-derive it and the neighbors
+                g_vals_[id] = kInfinity;
+                UpdateVertex(id);
+                UpdateNeighbors(id);
+            }
+        }
+        summary.found = Found();
+        summary.cost = summary.found ? Cost() : 0;
+        if (result) {
+            *result = summary;
+        }
+        return summary.found;
+    }
+
+    Grid board_;
+    std::vector<int> g_vals_;
+    std::vector<int> rhs_vals_;
+    IndexedMinHeap<DStarKey> open_list_;
+    Point start_{0, 0};
+    Point last_{0, 0};   // start at the last km update
+    Point goal_{0, 0};
+    int km_ = 0;
+};
+
+#endif
@@ -0,0 +1,317 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "board.h"
+#include "neighborhood.h"
+
+/* FLOW FIELD:
+ * Hundreds of agents heading for the same goal would each run nearly the same
+ * search. A flow field does it once: a Dijkstra that starts at the goal and
+ * runs over the whole board. Moves cost the same in both directions (and
+ * CanMove() holds both ways), so the distance it finds from the goal to a cell
+ * is the distance from the cell to the goal. Every cell keeps the move that
+ * leads one step closer to the goal, and an agent just follows the moves -
+ * O(path length), no search.
+ *
+ * MEMORY:
+ * The moves take 4 bits per cell, two cells per byte - that's all an agent
+ * reads (MoveBytes()). Update() needs the distances as well, an int per cell,
+ * so a field keeps 36 bits per cell in all (MemoryBytes()). The Dijkstra's
+ * open list is a binary heap with lazy deletion (a cell that gets a smaller
+ * distance is pushed again, the old entry is skipped), so there is no
+ * position table per cell either; the heap is empty between calls and only
+ * ever holds the frontier.
+ *
+ * Update() repairs the field after cells flipped between free and blocked:
+ *   - every cell whose stored move is gone (it was blocked, its target was,
+ *     or a diagonal now cuts a corner) loses its distance, and so does every
+ *     cell whose moves lead through such a cell - a walk down the tree of
+ *     moves, from parent to children.
+ *   - the cells that lost their distance, plus the cells around every flip
+ *     (a freed cell opens new moves), take the best move to a neighbor with a
+ *     distance, and the Dijkstra carries the improvements on from there.
+ * The work is proportional to the cells whose distance changes, not to the
+ * board.
+ */
+template <typename Neighborhood = FourConnected>
+class FlowField {
+  public:
+    static constexpr int kUnreachable = std::numeric_limits<int>::max();
+    static constexpr int kNoMove = 0xF;     // the move of the goal and of unreachable cells
+
+    static_assert(Neighborhood::kNeighbors < kNoMove, "moves must fit in 4 bits");
+
+    FlowField() = default;
+    FlowField( const GridView &board, Point goal ) { Build(board, goal); }
+
+    void Build( const GridView &board, Point goal ) {
+        rows_ = board.Rows();
+        cols_ = board.Cols();
+        goal_ = goal;
+        distances_.assign(std::size_t(rows_) * cols_, kUnreachable);
+        moves_.assign((distances_.size() + 1) / 2, 0xFF);
+        open_list_.clear();
+        settled_ = 0;
+        if (board.InBounds(goal.x, goal.y) && board(goal.x, goal.y) != State::kObstacle) {
+            distances_[GoalId()] = 0;
+            Push(GoalId(), 0);
+        }
+        Propagate(board);
+    }
+
+    Point Goal() const { return goal_; }
+
+    bool Reachable( Point cell ) const {
+        return cell.x >= 0 && cell.x < rows_ && cell.y >= 0 && cell.y < cols_ &&
+               distances_[Id(cell)] != kUnreachable;
+    }
+
+    // cost to the goal in the units of the Neighborhood policy, kUnreachable if there is no way
+    int Distance( int x, int y ) const { return distances_[std::size_t(x) * cols_ + y]; }
+
+    // the move towards the goal (an index into Neighborhood::kDelta), or kNoMove
+    int Move( int x, int y ) const { return Move(x * cols_ + y); }
+
+    // the next cell on the way to the goal; cell itself at the goal or when unreachable
+    Point Next( Point cell ) const {
+        const int move = Move(Id(cell));
+        if (move == kNoMove) {
+            return cell;
+        }
+        return Point{cell.x + Neighborhood::kDelta[move][0], cell.y + Neighborhood::kDelta[move][1]};
+    }
+
+    /**
+     * The path from `from` to the goal (both included), read off the field
+     * without a search. path keeps its capacity. Returns false with an empty
+     * path if the goal can't be reached from there.
+     */
+    bool Follow( Point from, std::vector<Point> &path ) const {
+        path.clear();
+        if (!Reachable(from)) {
+            return false;
+        }
+        path.push_back(from);
+        for (Point cell = from; cell != goal_;) {
+            cell = Next(cell);
+            path.push_back(cell);
+        }
+        return true;
+    }
+
+    /**
+     * Catches up with cells of the board that were flipped between free and
+     * blocked since the last Build() / Update(); board has to be the board
+     * after all of them.
+     */
+    void Update( const GridView &board, const std::vector<Point> &cells ) {
+        settled_ = 0;
+        lost_.clear();
+        for (const Point &cell : cells) {
+            ForEachAround(cell, [&](int id) {
+                if (distances_[id] != kUnreachable && !MoveStillThere(board, id)) {
+                    Lose(id);
+                }
+            });
+        }
+        // the children of a cell are the neighbors whose move leads onto it
+        for (std::size_t head = 0; head < lost_.size(); head++) {
+            const int id = lost_[head];
+            const int x = id / cols_;
+            const int y = id % cols_;
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int next_x = x + Neighborhood::kDelta[i][0];
+                const int next_y = y + Neighborhood::kDelta[i][1];
+                if (!InBounds(next_x, next_y)) {
+                    continue;
+                }
+                const int next = next_x * cols_ + next_y;
+                if (distances_[next] != kUnreachable && Move(next) == Reverse(i)) {
+                    Lose(next);
+                }
+            }
+        }
+
+        for (const int id : lost_) {
+            Reseed(board, id);
+        }
+        for (const Point &cell : cells) {
+            ForEachAround(cell, [&](int id) { Reseed(board, id); });
+        }
+        Propagate(board);
+    }
+
+    // cells the last Build() / Update() settled - the work it did
+    int Settled() const { return settled_; }
+
+    // bytes of the moves, the part an agent reads
+    std::size_t MoveBytes() const { return moves_.size(); }
+
+    // bytes the field keeps: the moves, the distances and the heap's buffer
+    std::size_t MemoryBytes() const {
+        return MoveBytes() + distances_.size() * sizeof(int) +
+               open_list_.capacity() * sizeof(Entry) + lost_.capacity() * sizeof(int);
+    }
+
+  private:
+    // open list entry, stale once the cell got a smaller distance
+    struct Entry {
+        int distance;
+        int id;
+    };
+
+    // std::push_heap() keeps the max on top, so "less" means "comes later"
+    struct Later {
+        bool operator()( const Entry &a, const Entry &b ) const { return a.distance > b.distance; }
+    };
+
+    void Push( int id, int distance ) {
+        open_list_.push_back(Entry{distance, id});
+        std::push_heap(open_list_.begin(), open_list_.end(), Later{});
+    }
+
+    int Id( Point cell ) const { return cell.x * cols_ + cell.y; }
+    int GoalId() const { return Id(goal_); }
+    bool InBounds( int x, int y ) const { return x >= 0 && x < rows_ && y >= 0 && y < cols_; }
+
+    int Move( int id ) const { return (moves_[id >> 1] >> ((id & 1) * 4)) & 0xF; }
+
+    void SetMove( int id, int move ) {
+        std::uint8_t &pair = moves_[id >> 1];
+        const int shift = (id & 1) * 4;
+        pair = (pair & ~(0xF << shift)) | (move << shift);
+    }
+
+    // the move with the opposite delta of move i
+    static int Reverse( int i ) {
+        static const std::array<int, Neighborhood::kNeighbors> reverse = [] {
+            std::array<int, Neighborhood::kNeighbors> moves{};
+            for (int a = 0; a < Neighborhood::kNeighbors; a++) {
+                for (int b = 0; b < Neighborhood::kNeighbors; b++) {
+                    if (Neighborhood::kDelta[a][0] == -Neighborhood::kDelta[b][0] &&
+                        Neighborhood::kDelta[a][1] == -Neighborhood::kDelta[b][1]) {
+                        moves[a] = b;
+                    }
+                }
+            }
+            return moves;
+        }();
+        return reverse[i];
+    }
+
+    // calls visit(id) for cell and its 8 neighbors on the board
+    template <typename Visit>
+    void ForEachAround( Point cell, Visit visit ) const {
+        for (int x = cell.x - 1; x <= cell.x + 1; x++) {
+            for (int y = cell.y - 1; y <= cell.y + 1; y++) {
+                if (InBounds(x, y)) {
+                    visit(x * cols_ + y);
+                }
+            }
+        }
+    }
+
+    // whether the stored move of id can still be made (not whether it still
+    // leads to the goal - that's up to the cell it leads to)
+    bool MoveStillThere( const GridView &board, int id ) const {
+        const int x = id / cols_;
+        const int y = id % cols_;
+        if (board(x, y) == State::kObstacle) {
+            return false;
+        }
+        const int move = Move(id);
+        if (move == kNoMove) {
+            return id == GoalId();
+        }
+        const int next_x = x + Neighborhood::kDelta[move][0];
+        const int next_y = y + Neighborhood::kDelta[move][1];
+        return board(next_x, next_y) != State::kObstacle &&
+               Neighborhood::CanMove(board, x, y, move);
+    }
+
+    void Lose( int id ) {
+        distances_[id] = kUnreachable;
+        SetMove(id, kNoMove);
+        lost_.push_back(id);
+    }
+
+    // takes the best move to a neighbor that has a distance, if it beats the
+    // cell's own, and queues the cell to pass it on
+    void Reseed( const GridView &board, int id ) {
+        const int x = id / cols_;
+        const int y = id % cols_;
+        if (board(x, y) == State::kObstacle) {
+            return;
+        }
+        int best = id == GoalId() ? 0 : kUnreachable;
+        int best_move = kNoMove;
+        for (int i = 0; i < Neighborhood::kNeighbors && best > 0; i++) {
+            const int next_x = x + Neighborhood::kDelta[i][0];
+            const int next_y = y + Neighborhood::kDelta[i][1];
+            if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                !Neighborhood::CanMove(board, x, y, i)) {
+                continue;
+            }
+            const int distance = distances_[next_x * cols_ + next_y];
+            if (distance != kUnreachable && distance + Neighborhood::kCost[i] < best) {
+                best = distance + Neighborhood::kCost[i];
+                best_move = i;
+            }
+        }
+        if (best < distances_[id]) {
+            distances_[id] = best;
+            SetMove(id, best_move);
+            Push(id, best);
+        }
+    }
+
+    // the Dijkstra: settles the queued cells in order of distance and offers
+    // every neighbor the move back onto them
+    void Propagate( const GridView &board ) {
+        while (!open_list_.empty()) {
+            std::pop_heap(open_list_.begin(), open_list_.end(), Later{});
+            const Entry entry = open_list_.back();
+            open_list_.pop_back();
+            const int id = entry.id;
+            if (entry.distance != distances_[id]) {
+                continue; // stale
+            }
+            settled_++;
+            const int x = id / cols_;
+            const int y = id % cols_;
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int next_x = x + Neighborhood::kDelta[i][0];
+                const int next_y = y + Neighborhood::kDelta[i][1];
+                if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                    !Neighborhood::CanMove(board, x, y, i)) {
+                    continue;
+                }
+                const int next = next_x * cols_ + next_y;
+                const int distance = distances_[id] + Neighborhood::kCost[i];
+                if (distance < distances_[next]) {
+                    distances_[next] = distance;
+                    SetMove(next, Reverse(i));
+                    Push(next, distance);
+                }
+            }
+        }
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    Point goal_{0, 0};
+    std::vector<int> distances_;            // per cell, x * cols + y
+    std::vector<std::uint8_t> moves_;       // 4 bits per cell, even cells in the low half
+    std::vector<Entry> open_list_;          // heap on the distance, empty between calls
+    std::vector<int> lost_;                 // cells Update() took the distance from
+    int settled_ = 0;
+};
+
+#endif
@@ -0,0 +1,681 @@
+#ifndef GRID_SEARCH_H
+#define GRID_SEARCH_H
+
+// pre-compiler instructions
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "board.h"
+#include "neighborhood.h"
+#include "open_list.h"
+#include "passability_bitmap.h"
+#include "search_context.h"
+#include "search_stats.h"
+
+using std::cout;
+using std::string;
+using std::vector;
+
+// NOTE: State now lives in board.h, next to the flat Grid type
+
+// NOTE: must be declared BEFORE readBoardFile()
+vector<State> ParseLine( std::string line ) {
+    std::istringstream sline(line);
+    int n;
+    char c;
+    vector<State> row;
+    
+    while (sline >> n >> c && c == ',') {
+        // TODO: Modify the line below to push_back
+        // a State::kEmpty if n is 0, and push_back
+        // a State::kObstacle otherwise.
+        if(n == 0) {
+            row.push_back(State::kEmpty);
+        }
+        else {
+            row.push_back(State::kObstacle);
+        }
+    }
+
+    return row;
+}
+
+vector<vector<State>> ReadBoardFile( std::string path ) {
+    // read board from file
+    std::ifstream board_file( path );
+    vector<vector<State>> board{};
+
+    if (board_file) {
+    //   cout << "The file stream has been created!" << "\n";
+      std::string line;
+        while (getline(board_file, line)) {
+            vector<State> row = ParseLine( line );
+            board.push_back( row );
+        }
+    } 
+
+    return board;
+}
+
+// ReadBoardFile() for the flat Grid. every row must have the same number of
+// cells, otherwise an empty Grid is returned.
+Grid ReadGridFile( std::string path ) {
+    std::ifstream board_file( path );
+    vector<State> cells;
+    int rows = 0;
+    int cols = 0;
+
+    if (board_file) {
+        std::string line;
+        while (getline(board_file, line)) {
+            vector<State> row = ParseLine( line );
+            if (rows == 0) {
+                cols = row.size();
+            } else if (static_cast<int>(row.size()) != cols) {
+                return Grid{};
+            }
+            cells.insert(cells.end(), row.begin(), row.end());
+            rows++;
+        }
+    }
+
+    Grid grid(rows, cols);
+    std::copy(cells.begin(), cells.end(), grid.Data());
+    return grid;
+}
+
+std::string CellString( State state ) {
+
+    // if(state == State::kObstacle) {
+    //     return "⛰️   ";
+    // }
+    // else {
+    //     return "0   ";
+    // }
+
+    switch(state) {
+        case State::kObstacle: return "⛰️   ";
+        case State::kPath: return "🚗   ";
+        case State::kStart: return "🚦   ";
+        case State::kFinish: return "🏁   ";
+        default: return "0   "; 
+    }
+}
+
+void PrintBoard( const vector<vector<State>> board) {
+    // range-based for loops
+    for(auto v : board) {       // could "strongly-type" State instead of auto
+        for(auto i : v) {       // could "strongly-type" State instead of auto
+            cout << CellString(i);
+        }
+        cout << "\n";
+    }
+
+    // for (int i = 0; i < board.size(); i++) {
+    //     for (int j = 0; j < board[i].size(); j++) {
+    //         cout << CellString(board[i][j]);
+    //     }
+    //     cout << "\n";
+    // }
+
+    return;
+}
+
+void PrintBoard( const Grid &grid ) {
+    for (int x = 0; x < grid.Rows(); x++) {
+        const State *row = grid.Row(x);
+        for (int y = 0; y < grid.Cols(); y++) {
+            cout << CellString(row[y]);
+        }
+        cout << "\n";
+    }
+}
+
+bool CheckValidCell( int x, int y, vector<vector<State>> &grid ) {
+    // check that the (x,y) coordinate pair is a valid grid location
+    // if( x < 0 || x > grid.size() || y < 0 || y > grid[0].size() ) {
+    //     return false;
+    // // check that the grid cell is not kClosed or kObstacle
+    // } else if( grid[x][y] == State::kClosed || grid[x][y] == State::kObstacle ) {
+    //     return false;
+    // } else {
+    //     return true;
+    // }
+
+    bool on_grid_x = (x >= 0 && x < static_cast<int>(grid.size()));
+    bool on_grid_y = (y >= 0 && y < static_cast<int>(grid[0].size()));
+    if (on_grid_x && on_grid_y)
+        return grid[x][y] == State::kEmpty;
+    return false;
+}
+
+bool CheckValidCell( int x, int y, const Grid &grid ) {
+    return grid.InBounds(x, y) && grid(x, y) == State::kEmpty;
+}
+
+/* SEARCH NODE:
+ * One entry of the CellSort() open list. It used to be a vector<int>{x, y, g, h}
+ * - a heap allocation per node, and Compare() took two of them by value, so
+ * every comparison of the sort allocated and freed twice. A plain struct is
+ * trivially copyable: the open list is one flat buffer, and sorting it only
+ * moves 16 bytes at a time.
+ */
+struct SearchNode {
+    int x;
+    int y;
+    int g;
+    int h;
+};
+
+static_assert(std::is_trivially_copyable<SearchNode>::value, "SearchNode must stay a POD");
+
+inline bool operator==( const SearchNode &a, const SearchNode &b ) {
+    return a.x == b.x && a.y == b.y && a.g == b.g && a.h == b.h;
+}
+
+inline bool operator!=( const SearchNode &a, const SearchNode &b ) { return !(a == b); }
+
+bool Compare( const SearchNode &node1, const SearchNode &node2 ) {
+    if (node1.g + node1.h > node2.g + node2.h) {
+        return true;
+    } else {
+        return false;
+    }
+
+    // int f1 = a[2] + a[3]; // f1 = g1 + h1
+    // int f2 = b[2] + b[3]; // f2 = g2 + h2
+    // return f1 > f2; 
+}
+
+void CellSort( vector<SearchNode> *v ) {
+    // sort the two-dimensional vector of ints by f-value in descending order
+    std::sort(v->begin(), v->end(), Compare);
+}
+
+int Heuristic( int x1, int y1, int x2, int y2 ) {
+    // comuptes the Manhattan distance to goal
+    return std::abs(x2-x1) + std::abs(y2-y1);
+
+}
+
+void AddToOpen( int x, int y, int g, int h, vector<SearchNode> &open_nodes, 
+                                            vector<vector<State>> &grid ) {
+    // adds the node to the open list and marks the grid cell as closed
+    open_nodes.push_back( SearchNode{x, y, g, h} );
+    grid[x][y] = State::kClosed;
+}
+
+/* "A common usage of const is to guard against accidentally changing a variable,
+ * especially when it is passed-by-reference as a function argument."
+ */
+void ExpandNeighbors( const SearchNode &current_node,
+                      int goal[2],
+                      vector<SearchNode> &open_nodes,
+                      vector<vector<State>> &grid ) {
+    // Loops through the current node's neighbors and calls appropriate functions
+    // to add neighbors to the open list
+
+    // NOTE: An array is a C++ container much like a vector, although without the
+    // ability to change size after initialization. Arrays can be accessed and
+    // iterated over just as vectors.
+    const int delta[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}}; // directional deltas
+
+    // get current node's data
+    const int current_x = current_node.x;
+    const int current_y = current_node.y;
+    const int current_g = current_node.g;
+
+    // loop through current node's potential neighbors
+    for( auto row : delta) {
+        int potential_x = current_x + row[0];
+        int potential_y = current_y + row[1];
+        // check that the potential neighbors is a valid grid cell & not closed
+        if( CheckValidCell(potential_x, potential_y, grid) ) {
+            // increment g-val, comoute h-val, add neighbor to open list
+            AddToOpen(potential_x,
+                      potential_y,
+                      current_g + 1, 
+                      Heuristic(potential_x, potential_y, goal[0], goal[1]),
+                      open_nodes,
+                      grid);
+        }
+    }
+}
+
+/**
+ * ExpandNeighbors() for the heap-based open list. The g-value of every cell
+ * lives in the SearchContext instead of on the open list, so a cell that is
+ * already open can still be reached by a cheaper route - its key is then
+ * lowered in place (decrease-key) rather than pushed a second time. The board
+ * itself is only read. The moves and their costs come from the Neighborhood
+ * policy, the cost of entering a cell from CellCost and the h-value from the
+ * Estimate (see neighborhood.h).
+ */
+template <typename Neighborhood, typename CellCost, typename Estimate, typename Board,
+          typename Cost>
+void ExpandNeighbors( int current_id,
+                      const Board &board,
+                      BasicSearchContext<Cost> &context,
+                      const CellCost &cell_cost,
+                      const Estimate &estimate ) {
+    const int current_x = board.IndexX(current_id);
+    const int current_y = board.IndexY(current_id);
+    const Cost current_g = context.G(current_id);
+
+    // first the neighbors that get a better g-value, then the open list
+    // updates for them, so SearchStats can time the two separately
+    struct Successor {
+        int id;
+        Cost g;
+        Cost h;
+    };
+    Successor successors[Neighborhood::kNeighbors];
+    int count = 0;
+    for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+        const int potential_x = current_x + Neighborhood::kDelta[i][0];
+        const int potential_y = current_y + Neighborhood::kDelta[i][1];
+        if (!board.InBounds(potential_x, potential_y) ||
+            board(potential_x, potential_y) == State::kObstacle ||
+            !Neighborhood::CanMove(board, current_x, current_y, i)) {
+            continue;
+        }
+        // cells that have already been expanded are done, open cells may
+        // still get a better g-value
+        const int id = board.Index(potential_x, potential_y);
+        const Cost g = current_g + Cost(Neighborhood::kCost[i]) * cell_cost(id);
+        if (!context.Closed(id) && g < context.G(id)) {
+            successors[count++] = Successor{id, g, estimate(potential_x, potential_y)};
+        }
+    }
+
+    if constexpr (kSearchStats) {
+        context.Stats().LapNeighbors();
+    }
+    auto &open_list = context.Open();
+    for (int i = 0; i < count; i++) {
+        const Successor &next = successors[i];
+        if constexpr (kSearchStats) {
+            SearchStats &stats = context.Stats();
+            (open_list.Contains(next.id) ? stats.reopens : stats.pushes)++;
+        }
+        context.Set(next.id, next.g, current_id);
+        open_list.PushOrDecrease(next.id, BasicOpenKey<Cost>{next.g + next.h, next.h});
+    }
+    if constexpr (kSearchStats) {
+        context.Stats().LapOpenList();
+    }
+}
+
+// summary of a single search, filled in when a SearchResult is passed in
+struct SearchResult {
+    bool found = false;
+    std::int64_t cost = 0;  // cost of the path that was found (its length when 4-connected)
+    int expansions = 0;     // nodes popped off the open list
+};
+
+/**
+ * The A* loop itself: runs on a read-only board and leaves everything it
+ * learns (g-values, parents, closed set) in the context. Stops at the first
+ * cell that is_goal(id) accepts and returns its id, -1 if there is none
+ * within reach; the cost is in the units of the Neighborhood policy. The
+ * estimate has to be admissible and consistent for the goal cells (for
+ * several of them, e.g. the smallest estimate of any one).
+ *
+ * Board is anything with the read-only accessors of GridView (Rows(), Size(),
+ * InBounds(), Index(), IndexX(), IndexY() and operator()) and int cell ids:
+ * the context has an entry for every cell of the board. A TiledBoard, too big
+ * for that, has its own TiledSearch (tiled_board.h says why). g- and f-values
+ * are in the Cost type of the context (see search_context.h).
+ *
+ * Afterwards context.Stats() tells where the time went (see search_stats.h).
+ */
+template <typename Neighborhood = FourConnected, typename CellCost, typename Estimate,
+          typename IsGoal, typename Board, typename Cost>
+int SearchBoardUntil( const Board &board, Point init, const IsGoal &is_goal,
+                      BasicSearchContext<Cost> &context, SearchResult *result,
+                      const CellCost &cell_cost, const Estimate &estimate ) {
+    /*
+    1. maintain a heap of open nodes, keyed on f = g + h
+    2. while there are still nodes to explore and goal not reached, pop and
+    expand the node with lowest f-value
+    */
+    static_assert(std::is_same_v<decltype(board.Index(0, 0)), int>,
+                  "SearchContext needs int cell ids, search a TiledBoard with TiledSearch");
+    SearchResult summary;
+    int goal_id = -1;
+    const std::int64_t start = kSearchStats ? SearchStats::Now() : 0;
+    context.Reset(board.Size());
+    [[maybe_unused]] SearchStats &stats = context.Stats();
+    if (board.Empty() || !board.InBounds(init.x, init.y) ||
+        board(init.x, init.y) == State::kObstacle) {
+        if constexpr (kSearchStats) {
+            stats.Finish(start);
+        }
+        if (result) {
+            *result = summary;
+        }
+        return goal_id;
+    }
+
+    // initialize the starting node
+    auto &open_list = context.Open();
+    const int init_id = board.Index(init.x, init.y);
+    const Cost h_val = estimate(init.x, init.y);
+    context.Set(init_id, 0, -1);
+    open_list.Push(init_id, BasicOpenKey<Cost>{h_val, h_val});
+    if constexpr (kSearchStats) {
+        stats.pushes = 1;
+        stats.peak_open = 1;
+    }
+
+    while( !open_list.Empty() ) {
+        if constexpr (kSearchStats) {
+            stats.StartSample(summary.expansions);
+        }
+        // O(log n) - no need to sort the whole open list
+        const int current_id = open_list.Pop().id;
+        context.Close(current_id);
+        summary.expansions++;
+        if constexpr (kSearchStats) {
+            stats.LapOpenList();
+        }
+
+        // check to see if current node is goal node
+        if (is_goal(current_id)) {
+            summary.found = true;
+            summary.cost = context.G(current_id);
+            goal_id = current_id;
+            break;
+        }
+        ExpandNeighbors<Neighborhood>( current_id, board, context, cell_cost, estimate );
+        if constexpr (kSearchStats) {
+            stats.peak_open = std::max(stats.peak_open, open_list.Size());
+        }
+    }
+    if constexpr (kSearchStats) {
+        stats.expansions = summary.expansions;
+        stats.peak_memory = context.MemoryBytes(stats.peak_open);
+        stats.Finish(start);
+    }
+    if (result) {
+        *result = summary;
+    }
+    return goal_id;
+}
+
+// SearchBoardUntil() for a single goal, returns whether it was reached
+template <typename Neighborhood = FourConnected, typename CellCost, typename Estimate,
+          typename Board, typename Cost>
+bool SearchBoard( const Board &board, Point init, Point goal, BasicSearchContext<Cost> &context,
+                  SearchResult *result, const CellCost &cell_cost, const Estimate &estimate ) {
+    // a goal off the board can't be reached: starting off the board too makes
+    // the search give up right away, with the context reset as usual
+    const bool on_board = board.InBounds(goal.x, goal.y);
+    const int goal_id = on_board ? board.Index(goal.x, goal.y) : -1;
+    return SearchBoardUntil<Neighborhood>(board, on_board ? init : Point{-1, -1},
+                                          [goal_id](int id) { return id == goal_id; }, context,
+                                          result, cell_cost, estimate) != -1;
+}
+
+// SearchBoard() with the heuristic of the Neighborhood policy
+template <typename Neighborhood = FourConnected, typename CellCost = UniformCost, typename Board,
+          typename Cost>
+bool SearchBoard( const Board &board, Point init, Point goal, BasicSearchContext<Cost> &context,
+                  SearchResult *result = nullptr, const CellCost &cell_cost = CellCost{} ) {
+    return SearchBoard<Neighborhood>(board, init, goal, context, result, cell_cost,
+                                     GoalDistance<Neighborhood>{goal, cell_cost.MinCost()});
+}
+
+/**
+ * The board as Search() has always returned it: expanded cells are kPath,
+ * cells that were reached but never expanded kClosed.
+ */
+Grid MarkSearch( const GridView &board, const SearchContext &context, Point init, Point goal ) {
+    Grid grid(board);
+    State *cells = grid.Data();
+    for (int id = 0; id < grid.Size(); id++) {
+        if (context.Closed(id)) {
+            cells[id] = State::kPath;
+        } else if (context.Seen(id)) {
+            cells[id] = State::kClosed;
+        }
+    }
+    grid(init.x, init.y) = State::kStart;
+    grid(goal.x, goal.y) = State::kFinish;
+    return grid;
+}
+
+/** 
+ * Implementation of A* search algorithm
+ */
+template <typename Neighborhood = FourConnected>
+Grid Search( const Grid &grid, int init[2], int goal[2], SearchContext &context,
+             SearchResult *result = nullptr ) {
+    Point start{init[0], init[1]};
+    Point finish{goal[0], goal[1]};
+    if (!SearchBoard<Neighborhood>(grid.View(), start, finish, context, result)) {
+        // We've run out of new nodes to explore and haven't found a path.
+        cout << "No path found!" << "\n";
+        return Grid{};
+    }
+    return MarkSearch(grid.View(), context, start, finish);
+}
+
+template <typename Neighborhood = FourConnected>
+Grid Search( const Grid &grid, int init[2], int goal[2], SearchResult *result = nullptr ) {
+    SearchContext context;
+    return Search<Neighborhood>( grid, init, goal, context, result );
+}
+
+vector<vector<State>> Search( vector<vector<State>> grid,
+                              int init[2],
+                              int goal[2] ) {
+    return Search( Grid(grid), init, goal ).ToNested();
+}
+
+/**
+ * Follows the parent links of a finished search back from goal. The path
+ * goes from init to goal (both included); path keeps its capacity, so a
+ * reused vector doesn't allocate.
+ */
+template <typename Board, typename Cost>
+void ExtractPath( const Board &board, const BasicSearchContext<Cost> &context, Point goal,
+                  vector<Point> &path ) {
+    path.clear();
+    for (int id = board.Index(goal.x, goal.y); id != -1; id = context.Parent(id)) {
+        path.push_back(Point{board.IndexX(id), board.IndexY(id)});
+    }
+    std::reverse(path.begin(), path.end());
+}
+
+/**
+ * A* on a read-only board: all the per-query state lives in the SearchContext,
+ * so the board is never copied or written to and several threads can search
+ * the same board at once (each with its own context). Fills path (empty if
+ * there is none) and returns whether one was found.
+ */
+template <typename Neighborhood = FourConnected, typename CellCost, typename Estimate,
+          typename Board, typename Cost>
+bool FindPath( const Board &board, Point init, Point goal, BasicSearchContext<Cost> &context,
+               vector<Point> &path, SearchResult *result, const CellCost &cell_cost,
+               const Estimate &estimate ) {
+    path.clear();
+    if (!SearchBoard<Neighborhood>(board, init, goal, context, result, cell_cost, estimate)) {
+        return false;
+    }
+    ExtractPath(board, context, goal, path);
+    return true;
+}
+
+template <typename Neighborhood = FourConnected, typename CellCost = UniformCost, typename Board,
+          typename Cost>
+bool FindPath( const Board &board, Point init, Point goal, BasicSearchContext<Cost> &context,
+               vector<Point> &path, SearchResult *result = nullptr,
+               const CellCost &cell_cost = CellCost{} ) {
+    return FindPath<Neighborhood>(board, init, goal, context, path, result, cell_cost,
+                                  GoalDistance<Neighborhood>{goal, cell_cost.MinCost()});
+}
+
+template <typename Neighborhood = FourConnected, typename CellCost = UniformCost, typename Board,
+          typename Cost>
+vector<Point> FindPath( const Board &board, Point init, Point goal,
+                        BasicSearchContext<Cost> &context, SearchResult *result = nullptr,
+                        const CellCost &cell_cost = CellCost{} ) {
+    vector<Point> path;
+    FindPath<Neighborhood>(board, init, goal, context, path, result, cell_cost);
+    return path;
+}
+
+/**
+ * ExpandNeighbors() driven by a PassabilityBitmap: a single NeighborMask4()
+ * call replaces the bounds checks and State compares, and we only loop over
+ * the set bits. Expanded cells don't need a check either - with a
+ * consistent heuristic their g-value can't be improved on.
+ */
+void ExpandNeighbors( int current_id,
+                      Point goal,
+                      const GridView &board,
+                      SearchContext &context,
+                      const PassabilityBitmap &free_cells ) {
+    const int current_x = board.IndexX(current_id);
+    const int current_y = board.IndexY(current_id);
+    const int g = context.G(current_id) + 1;
+
+    for (unsigned mask = free_cells.NeighborMask4(current_x, current_y); mask; mask &= mask - 1) {
+        const int *d = kBitmapDelta4[__builtin_ctz(mask)];
+        const int potential_x = current_x + d[0];
+        const int potential_y = current_y + d[1];
+        const int id = board.Index(potential_x, potential_y);
+        if (g < context.G(id)) {
+            const int h = Heuristic(potential_x, potential_y, goal.x, goal.y);
+            context.Set(id, g, current_id);
+            context.Open().PushOrDecrease(id, OpenKey{g + h, h});
+        }
+    }
+}
+
+// SearchBoard() with a prebuilt passability bitmap of the same board
+bool SearchBoard( const GridView &board, const PassabilityBitmap &free_cells, Point init,
+                  Point goal, SearchContext &context, SearchResult *result = nullptr ) {
+    SearchResult summary;
+    context.Reset(board.Size());
+    if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+        !free_cells.IsFree(init.x, init.y)) {
+        if (result) {
+            *result = summary;
+        }
+        return false;
+    }
+
+    OpenList &open_list = context.Open();
+    const int init_id = board.Index(init.x, init.y);
+    const int goal_id = board.Index(goal.x, goal.y);
+    int h_val = Heuristic(init.x, init.y, goal.x, goal.y);
+    context.Set(init_id, 0, -1);
+    open_list.Push(init_id, OpenKey{h_val, h_val});
+
+    while( !open_list.Empty() ) {
+        const int current_id = open_list.Pop().id;
+        context.Close(current_id);
+        summary.expansions++;
+
+        if (current_id == goal_id) {
+            summary.found = true;
+            summary.cost = context.G(current_id);
+            break;
+        }
+        ExpandNeighbors( current_id, goal, board, context, free_cells );
+    }
+    if (result) {
+        *result = summary;
+    }
+    return summary.found;
+}
+
+// Search() with a prebuilt passability bitmap of the same board
+Grid Search( const Grid &grid, const PassabilityBitmap &free_cells, int init[2], int goal[2],
+             SearchResult *result = nullptr ) {
+    SearchContext context;
+    Point start{init[0], init[1]};
+    Point finish{goal[0], goal[1]};
+    if (!SearchBoard(grid.View(), free_cells, start, finish, context, result)) {
+        cout << "No path found!" << "\n";
+        return Grid{};
+    }
+    return MarkSearch(grid.View(), context, start, finish);
+}
+
+/** 
+ * The original A* search, which calls CellSort() on every iteration. Kept
+ * around as a reference for the unit tests and the benchmark.
+ *
+ * The open list lives in a buffer the caller keeps between searches: it is
+ * only cleared, so once it has grown to the largest open list the search
+ * itself allocates nothing (the board it returns aside).
+ */
+vector<vector<State>> SearchCellSort( vector<vector<State>> grid,
+                              int init[2],
+                              int goal[2],
+                              vector<SearchNode> &open_nodes ) {
+    /*
+    1. maintain a list of open nodes
+    2. while there are still nodes to explore and goal not reached, expand node
+    with lowest f-value
+    */
+
+    // start over with the vector of open nodes
+    open_nodes.clear();
+
+    // initialize the starting node
+    int h_val = Heuristic(init[0], init[1], goal[0], goal[1]);
+    AddToOpen( init[0], init[1], 0, h_val, open_nodes, grid);
+
+    int iter = 0;
+    while( open_nodes.size() > 0 ) {
+
+        // // TODO: Sort the open list using `CellSort`, and get the current node
+        CellSort( &open_nodes );
+        // vector<int> current_node = open_nodes[0];    // my method - incorrect!
+
+        // returns a reference to the last element in the vector.
+        SearchNode current_node = open_nodes.back();
+
+        // removes the last element in the vector, effectively reducing the container size by one.
+        open_nodes.pop_back();
+
+        // TODO: Get the x and y values from the current node,
+        // and set grid[x][y] to kPath.
+        grid[current_node.x][current_node.y] = State::kPath;
+
+        // check to see if current node is goal node
+        if (current_node.x == goal[0] && current_node.y == goal[1]) {
+            grid[init[0]][init[1]] = State::kStart;
+            grid[goal[0]][goal[1]] = State::kFinish;
+            return grid;
+        } else {
+            // if not goal, expand search to current node's neighbors
+            ExpandNeighbors( current_node, goal, open_nodes, grid );
+        }
+        iter++;
+    }
+    // We've run out of new nodes to explore and haven't found a path.
+    cout << "No path found!" << "\n";
+    return std::vector<vector<State>>{};
+}
+
+// SearchCellSort() with an open list of its own
+vector<vector<State>> SearchCellSort( vector<vector<State>> grid,
+                              int init[2],
+                              int goal[2] ) {
+    vector<SearchNode> open_nodes;
+    return SearchCellSort(std::move(grid), init, goal, open_nodes);
+}
+
+#endif
@@ -0,0 +1,380 @@
+#ifndef HDA_STAR_H
+#define HDA_STAR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+
+/* HASH DISTRIBUTED A* (HDA*):
+ * Kishimoto, Fukunaga & Botea. One big query on several cores. Every cell is
+ * owned by one thread, picked by a hash, and only its owner ever touches its
+ * g-value and parent or keeps it on an open list. A thread expands the best
+ * node of its own open list; a neighbor that belongs to another thread is
+ * sent to it as (cell, g, parent) through a lock-free single-producer /
+ * single-consumer ring, one per pair of threads, and the owner relaxes it
+ * when it drains its inbox. Nodes come off the open lists in a different
+ * order than in plain A*, so a node can be reached again with a smaller g and
+ * is then simply reopened.
+ *
+ * The hash works on 8x8 tiles instead of single cells: with per-cell owners
+ * nearly every generated node would be a message, with tiles only the moves
+ * that leave a tile are.
+ *
+ * Optimality: the owner of goal keeps the best cost found so far in a shared
+ * atomic. Nodes with g + h >= best are neither sent nor expanded, and the
+ * search only stops once no thread has a node below best left and no message
+ * is under way - with an admissible heuristic, best is then optimal.
+ *
+ * Termination detection: in_flight counts the messages that were generated
+ * but not yet processed (a sender counts them before it queues them). A thread
+ * without work goes idle; receiving a message wakes it up again, which bumps
+ * the epoch before the message is counted off. Everything is over when all
+ * threads are idle and nothing is in flight, read without an epoch change in
+ * between: idle threads don't send, so no message can have slipped through.
+ * An idle thread first just yields, and after kSpinRounds empty rounds it
+ * sleeps, twice as long every round up to kMaxIdleSleep - a starved search
+ * doesn't keep every core busy, at the price of noticing new work (or the
+ * end of the search) that much later.
+ *
+ * The path is read off the parent links after all threads have joined.
+ */
+
+// lock-free ring buffer for exactly one producer and one consumer thread
+template <typename T>
+class SpscQueue {
+  public:
+    // capacity has to be a power of two
+    explicit SpscQueue( std::size_t capacity = 4096 ) : slots_(capacity), mask_(capacity - 1) {}
+
+    bool TryPush( const T &value ) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+            return false;
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop( T &value ) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    std::vector<T> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0};  // written by the consumer
+    alignas(64) std::atomic<std::size_t> tail_{0};  // written by the producer
+};
+
+template <typename Neighborhood = FourConnected>
+class HdaStar {
+  public:
+    // num_threads = 0 uses one thread per hardware thread
+    explicit HdaStar( int num_threads = 0 ) {
+        if (num_threads <= 0) {
+            num_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        workers_ = std::vector<Worker>(num_threads);
+        for (Worker &worker : workers_) {
+            worker.outboxes.resize(num_threads);
+        }
+        for (int i = 0; i < num_threads * num_threads; i++) {
+            queues_.push_back(std::make_unique<SpscQueue<Message>>());
+        }
+    }
+
+    HdaStar( const HdaStar & ) = delete;
+    HdaStar &operator=( const HdaStar & ) = delete;
+
+    int Threads() const { return static_cast<int>(workers_.size()); }
+
+    /**
+     * Optimal path from init to goal (both included) like FindPath(), searched
+     * by all threads together. The calling thread is one of them.
+     */
+    bool FindPath( const GridView &board, Point init, Point goal, std::vector<Point> &path,
+                   SearchResult *result = nullptr ) {
+        path.clear();
+        SearchResult summary;
+        if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+            board(init.x, init.y) == State::kObstacle || board(goal.x, goal.y) == State::kObstacle) {
+            if (result) {
+                *result = summary;
+            }
+            return false;
+        }
+
+        StartQuery(board);
+        board_ = &board;
+        goal_ = goal;
+        goal_id_ = board.Index(goal.x, goal.y);
+        best_.store(kInfinity);
+        in_flight_.store(0);
+        idle_.store(0);
+        epoch_.store(0);
+        done_.store(false);
+
+        const int init_id = board.Index(init.x, init.y);
+        Worker &owner = workers_[Owner(init_id)];
+        if (Relax(init_id, 0, -1)) {
+            owner.open_list.push_back(Entry{H(init_id), H(init_id), 0, init_id});
+        }
+
+        std::vector<std::thread> threads;
+        for (int i = 1; i < Threads(); i++) {
+            threads.emplace_back(&HdaStar::Work, this, i);
+        }
+        Work(0);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        for (const Worker &worker : workers_) {
+            summary.expansions += worker.expansions;
+        }
+        summary.found = best_.load() != kInfinity;
+        if (summary.found) {
+            for (int id = goal_id_; id != -1; id = nodes_[id].parent) {
+                path.push_back(Point{board.IndexX(id), board.IndexY(id)});
+            }
+            std::reverse(path.begin(), path.end());
+            summary.cost = nodes_[goal_id_].g;
+        }
+        if (result) {
+            *result = summary;
+        }
+        return summary.found;
+    }
+
+  private:
+    static constexpr int kInfinity = std::numeric_limits<int>::max();
+    static constexpr int kTile = 8;     // owners are assigned per kTile x kTile block
+    static constexpr int kSpinRounds = 64;  // idle rounds that only yield before sleeping
+    static constexpr std::chrono::microseconds kMaxIdleSleep{256};
+
+    // a node generated for another thread
+    struct Message {
+        int id;
+        int g;
+        int parent;
+    };
+
+    // open list entry, stale once the cell got a smaller g
+    struct Entry {
+        int f;
+        int h;
+        int g;
+        int id;
+    };
+
+    // std::push_heap() keeps the max on top, so "less" means "comes later"
+    struct Later {
+        bool operator()( const Entry &a, const Entry &b ) const {
+            return a.f > b.f || (a.f == b.f && a.h > b.h);
+        }
+    };
+
+    struct Node {
+        std::uint32_t seen = 0;
+        int g = kInfinity;
+        int parent = -1;
+    };
+
+    struct alignas(64) Worker {
+        std::vector<Entry> open_list;
+        std::vector<std::vector<Message>> outboxes;    // per thread, waiting for room in its ring
+        long long expansions = 0;
+    };
+
+    void StartQuery( const GridView &board ) {
+        if (static_cast<int>(nodes_.size()) != board.Size()) {
+            nodes_.assign(board.Size(), Node{});
+            query_ = 0;
+        }
+        if (++query_ == 0) {
+            std::fill(nodes_.begin(), nodes_.end(), Node{});
+            query_ = 1;
+        }
+        for (Worker &worker : workers_) {
+            worker.open_list.clear();
+            worker.expansions = 0;
+            for (auto &outbox : worker.outboxes) {
+                outbox.clear();
+            }
+        }
+    }
+
+    int Owner( int id ) const {
+        const std::uint64_t tile = std::uint64_t(board_->IndexX(id) / kTile) << 32 |
+                                   std::uint32_t(board_->IndexY(id) / kTile);
+        return (tile * 0x9E3779B97F4A7C15ull >> 32) % workers_.size();
+    }
+
+    int H( int id ) const {
+        return Neighborhood::Heuristic(board_->IndexX(id), board_->IndexY(id), goal_.x, goal_.y);
+    }
+
+    int G( int id ) const { return nodes_[id].seen == query_ ? nodes_[id].g : kInfinity; }
+
+    // only ever called by the owner of id. returns whether id goes on the open list
+    bool Relax( int id, int g, int parent ) {
+        if (g >= G(id)) {
+            return false;
+        }
+        nodes_[id] = Node{query_, g, parent};
+        if (id != goal_id_) {
+            return true;
+        }
+        int best = best_.load();
+        while (g < best && !best_.compare_exchange_weak(best, g)) {
+        }
+        return false;
+    }
+
+    void Push( Worker &worker, int id, int g ) {
+        const int h = H(id);
+        worker.open_list.push_back(Entry{g + h, h, g, id});
+        std::push_heap(worker.open_list.begin(), worker.open_list.end(), Later{});
+    }
+
+    // moves queued messages into the rings, returns whether all of them fit
+    bool Flush( int self ) {
+        bool flushed = true;
+        Worker &worker = workers_[self];
+        for (int to = 0; to < Threads(); to++) {
+            std::vector<Message> &outbox = worker.outboxes[to];
+            std::size_t sent = 0;
+            while (sent < outbox.size() && queues_[self * Threads() + to]->TryPush(outbox[sent])) {
+                sent++;
+            }
+            outbox.erase(outbox.begin(), outbox.begin() + sent);
+            flushed = flushed && outbox.empty();
+        }
+        return flushed;
+    }
+
+    void Expand( int self, const Entry &entry ) {
+        Worker &worker = workers_[self];
+        worker.expansions++;
+        const GridView &board = *board_;
+        const int x = board.IndexX(entry.id);
+        const int y = board.IndexY(entry.id);
+        const int best = best_.load(std::memory_order_relaxed);
+        for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+            const int next_x = x + Neighborhood::kDelta[i][0];
+            const int next_y = y + Neighborhood::kDelta[i][1];
+            if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                !Neighborhood::CanMove(board, x, y, i)) {
+                continue;
+            }
+            const int next = board.Index(next_x, next_y);
+            const int g = entry.g + Neighborhood::kCost[i];
+            if (g + Neighborhood::Heuristic(next_x, next_y, goal_.x, goal_.y) >= best) {
+                continue;
+            }
+            const int owner = Owner(next);
+            if (owner == self) {
+                if (Relax(next, g, entry.id)) {
+                    Push(worker, next, g);
+                }
+            } else {
+                in_flight_.fetch_add(1);
+                worker.outboxes[owner].push_back(Message{next, g, entry.id});
+            }
+        }
+    }
+
+    void Work( int self ) {
+        Worker &worker = workers_[self];
+        bool idle = false;
+        int idle_rounds = 0;
+        Message message;
+        while (!done_.load()) {
+            // inbox first: the nodes other threads generated for us
+            for (int from = 0; from < Threads(); from++) {
+                while (queues_[from * Threads() + self]->TryPop(message)) {
+                    if (idle) {
+                        epoch_.fetch_add(1);
+                        idle_.fetch_sub(1);
+                        idle = false;
+                        idle_rounds = 0;
+                    }
+                    if (Relax(message.id, message.g, message.parent)) {
+                        Push(worker, message.id, message.g);
+                    }
+                    in_flight_.fetch_sub(1);
+                }
+            }
+            const bool flushed = Flush(self);
+
+            // then a few expansions of our own
+            bool expanded = false;
+            for (int n = 0; n < 64 && !worker.open_list.empty(); n++) {
+                std::pop_heap(worker.open_list.begin(), worker.open_list.end(), Later{});
+                const Entry entry = worker.open_list.back();
+                worker.open_list.pop_back();
+                if (entry.g != G(entry.id)) {
+                    continue; // stale
+                }
+                if (entry.f >= best_.load(std::memory_order_relaxed)) {
+                    // nothing left here that could beat the incumbent
+                    worker.open_list.clear();
+                    break;
+                }
+                Expand(self, entry);
+                expanded = true;
+            }
+            if (expanded || !flushed || !worker.open_list.empty()) {
+                continue;
+            }
+
+            if (!idle) {
+                idle = true;
+                idle_.fetch_add(1);
+            }
+            const std::uint64_t epoch = epoch_.load();
+            if (idle_.load() == Threads() && in_flight_.load() == 0 && epoch_.load() == epoch) {
+                done_.store(true);
+            } else if (idle_rounds++ < kSpinRounds) {
+                std::this_thread::yield();
+            } else {
+                const int doublings = std::min(idle_rounds - kSpinRounds, 8);
+                std::this_thread::sleep_for(
+                    std::min(kMaxIdleSleep, std::chrono::microseconds(1 << doublings)));
+            }
+        }
+    }
+
+    std::vector<Worker> workers_;
+    std::vector<std::unique_ptr<SpscQueue<Message>>> queues_;  // from * Threads() + to
+    std::vector<Node> nodes_;
+    std::uint32_t query_ = 0;
+
+    // the query in progress
+    const GridView *board_ = nullptr;
+    Point goal_{0, 0};
+    int goal_id_ = 0;
+    std::atomic<int> best_{kInfinity};          // cost of the best path found so far
+    std::atomic<long long> in_flight_{0};       // messages generated but not processed yet
+    std::atomic<int> idle_{0};                  // threads without work
+    std::atomic<std::uint64_t> epoch_{0};       // bumped whenever an idle thread wakes up
+    std::atomic<bool> done_{false};
+};
+
+#endif
@@ -0,0 +1,532 @@
+#ifndef HPA_STAR_H
+#define HPA_STAR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "open_list.h"
+
+/* HIERARCHICAL PATHFINDING (HPA*):
+ * Precomputation (once per board):
+ *   1. split the board into square clusters of cluster_size x cluster_size
+ *   2. along every border between two neighboring clusters, find the
+ *      "entrances" - maximal runs of cells that are free on both sides. Short
+ *      entrances get one transition in the middle, long ones one at each end.
+ *      Both cells of a transition become nodes of the abstract graph, joined
+ *      by an inter-cluster edge of cost 1.
+ *   3. inside every cluster, a BFS from each node gives the intra-cluster
+ *      edges (shortest distance staying inside the cluster).
+ * Query:
+ *   1. connect init and goal to the nodes of their clusters (one BFS each)
+ *   2. A* on the abstract graph (Manhattan Heuristic() between node cells)
+ *   3. refine: replace every intra-cluster edge with a BFS path inside its
+ *      cluster, inter-cluster edges are already single steps
+ *
+ * The abstract graph is small compared to the board, so a query only pays for
+ * two cluster-sized BFS's, a small A* and the refinement. Paths are near
+ * optimal rather than optimal: they are restricted to pass through the chosen
+ * transitions.
+ *
+ * The precomputation can be written to disk with Save() and read back with
+ * Load(). It stores a hash of the board, so Matches() can tell whether it still
+ * belongs to the board.
+ */
+
+class HierarchicalMap {
+  public:
+    HierarchicalMap() = default;
+
+    void Build( const GridView &board, int cluster_size = 16 ) {
+        rows_ = board.Rows();
+        cols_ = board.Cols();
+        cluster_size_ = cluster_size;
+        clusters_x_ = (rows_ + cluster_size - 1) / cluster_size;
+        clusters_y_ = (cols_ + cluster_size - 1) / cluster_size;
+        board_hash_ = BoardHash(board);
+        node_cells_.clear();
+        edges_.clear();
+        node_of_cell_.clear();
+        cluster_nodes_.assign(clusters_x_ * clusters_y_, {});
+
+        BuildEntrances(board);
+        BuildIntraEdges(board);
+        ResetScratch();
+    }
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    int ClusterSize() const { return cluster_size_; }
+    int NodeCount() const { return node_cells_.size(); }
+
+    int EdgeCount() const {
+        int count = 0;
+        for (const auto &edges : edges_) {
+            count += edges.size();
+        }
+        return count / 2;
+    }
+
+    // true if this precomputation was built for `board`
+    bool Matches( const GridView &board ) const {
+        return board.Rows() == rows_ && board.Cols() == cols_ && BoardHash(board) == board_hash_;
+    }
+
+    /* file layout (host byte order):
+     *   "HPA1", u32 version, u32 rows, u32 cols, u32 cluster size, u64 board hash,
+     *   u32 node count, node count x i32 cell (x * cols + y),
+     *   per node: u32 edge count, edge count x (i32 to, i32 cost)
+     */
+    bool Save( const std::string &path ) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        file.write(kMagic, 4);
+        Write<std::uint32_t>(file, kVersion);
+        Write<std::uint32_t>(file, rows_);
+        Write<std::uint32_t>(file, cols_);
+        Write<std::uint32_t>(file, cluster_size_);
+        Write<std::uint64_t>(file, board_hash_);
+        Write<std::uint32_t>(file, node_cells_.size());
+        file.write(reinterpret_cast<const char *>(node_cells_.data()),
+                   node_cells_.size() * sizeof(int));
+        for (const auto &edges : edges_) {
+            Write<std::uint32_t>(file, edges.size());
+            file.write(reinterpret_cast<const char *>(edges.data()), edges.size() * sizeof(Edge));
+        }
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Replaces the map with the one in the file. Returns false, and keeps the
+     * map as it was, if the file is missing, truncated or doesn't hold a
+     * consistent graph: every node on a distinct cell of the board, every edge
+     * to a node that exists.
+     */
+    bool Load( const std::string &path ) {
+        std::ifstream file(path, std::ios::binary);
+        char magic[4];
+        std::uint32_t version = 0;
+        std::uint32_t rows = 0;
+        std::uint32_t cols = 0;
+        std::uint32_t cluster_size = 0;
+        std::uint32_t node_count = 0;
+        HierarchicalMap loaded;
+        if (!file.read(magic, 4) || std::string(magic, 4) != std::string(kMagic, 4) ||
+            !Read(file, version) || version != kVersion ||
+            !Read(file, rows) || !Read(file, cols) || !Read(file, cluster_size) ||
+            !Read(file, loaded.board_hash_) || !Read(file, node_count)) {
+            return false;
+        }
+        // cells and the cluster scratch are indexed with int
+        const std::uint64_t cells = std::uint64_t(rows) * cols;
+        if (cluster_size == 0 || cells > std::uint64_t(std::numeric_limits<int>::max()) ||
+            std::uint64_t(cluster_size) * cluster_size >
+                std::uint64_t(std::numeric_limits<int>::max()) ||
+            node_count > cells) {
+            return false;
+        }
+        loaded.rows_ = rows;
+        loaded.cols_ = cols;
+        loaded.cluster_size_ = cluster_size;
+        loaded.clusters_x_ = (loaded.rows_ + loaded.cluster_size_ - 1) / loaded.cluster_size_;
+        loaded.clusters_y_ = (loaded.cols_ + loaded.cluster_size_ - 1) / loaded.cluster_size_;
+        loaded.cluster_nodes_.assign(std::size_t(loaded.clusters_x_) * loaded.clusters_y_, {});
+
+        // read one value at a time: a corrupt count runs into the end of the
+        // file instead of into a huge allocation
+        for (std::uint32_t node = 0; node < node_count; node++) {
+            std::int32_t cell = 0;
+            if (!Read(file, cell) || cell < 0 || std::uint64_t(cell) >= cells ||
+                !loaded.node_of_cell_.emplace(cell, node).second) {
+                return false;
+            }
+            loaded.node_cells_.push_back(cell);
+            loaded.cluster_nodes_[loaded.ClusterOf(cell / loaded.cols_, cell % loaded.cols_)]
+                .push_back(node);
+        }
+        loaded.edges_.assign(node_count, {});
+        for (auto &edges : loaded.edges_) {
+            std::uint32_t edge_count = 0;
+            if (!Read(file, edge_count) || edge_count > node_count) {
+                return false;
+            }
+            for (std::uint32_t i = 0; i < edge_count; i++) {
+                Edge edge;
+                if (!Read(file, edge) || edge.to < 0 || std::uint32_t(edge.to) >= node_count ||
+                    edge.cost < 0) {
+                    return false;
+                }
+                edges.push_back(edge);
+            }
+        }
+
+        loaded.ResetScratch();
+        *this = std::move(loaded);
+        return true;
+    }
+
+    // path from init to goal (both included), empty if there is none or the
+    // board isn't the size the map was built for
+    std::vector<Point> FindPath( const GridView &board, Point init, Point goal,
+                                 SearchResult *result = nullptr ) {
+        SearchResult summary;
+        if (result) {
+            *result = summary;
+        }
+        if (board.Rows() != rows_ || board.Cols() != cols_ ||
+            !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+            board(init.x, init.y) == State::kObstacle || board(goal.x, goal.y) == State::kObstacle) {
+            return {};
+        }
+
+        // 1. temporary nodes for init (S) and goal (T)
+        const int S = NodeCount();
+        const int T = NodeCount() + 1;
+        std::vector<Edge> start_links;
+        int direct = kInfinity;
+        LocalBfs(board, init);
+        for (int node : cluster_nodes_[ClusterOf(init.x, init.y)]) {
+            const int d = LocalDistance(CellPoint(node_cells_[node]));
+            if (d != kInfinity) {
+                start_links.push_back(Edge{node, d});
+            }
+        }
+        if (ClusterOf(init.x, init.y) == ClusterOf(goal.x, goal.y)) {
+            direct = LocalDistance(goal);
+        }
+        LocalBfs(board, goal);
+        std::vector<int> goal_nodes;
+        for (int node : cluster_nodes_[ClusterOf(goal.x, goal.y)]) {
+            const int d = LocalDistance(CellPoint(node_cells_[node]));
+            if (d != kInfinity) {
+                goal_link_[node] = d;
+                goal_nodes.push_back(node);
+            }
+        }
+
+        // 2. A* on the abstract graph
+        auto cell_of = [&](int node) {
+            return node == S ? init : node == T ? goal : CellPoint(node_cells_[node]);
+        };
+        auto relax = [&](int from, int to, int cost) {
+            const int g = g_vals_[from] + cost;
+            if (g < g_vals_[to]) {
+                if (g_vals_[to] == kInfinity) {
+                    touched_.push_back(to);
+                }
+                g_vals_[to] = g;
+                parents_[to] = from;
+                const Point p = cell_of(to);
+                const int h = Heuristic(p.x, p.y, goal.x, goal.y);
+                open_list_.PushOrDecrease(to, OpenKey{g + h, h});
+            }
+        };
+
+        g_vals_[S] = 0;
+        touched_.push_back(S);
+        const int h_init = Heuristic(init.x, init.y, goal.x, goal.y);
+        open_list_.Push(S, OpenKey{h_init, h_init});
+        bool found = false;
+        while (!open_list_.Empty()) {
+            const int u = open_list_.Pop().id;
+            summary.expansions++;
+            if (u == T) {
+                found = true;
+                break;
+            }
+            if (u == S) {
+                for (const Edge &edge : start_links) {
+                    relax(S, edge.to, edge.cost);
+                }
+                if (direct != kInfinity) {
+                    relax(S, T, direct);
+                }
+                continue;
+            }
+            for (const Edge &edge : edges_[u]) {
+                relax(u, edge.to, edge.cost);
+            }
+            if (goal_link_[u] != kInfinity) {
+                relax(u, T, goal_link_[u]);
+            }
+        }
+
+        // 3. refine the abstract path into cells
+        std::vector<Point> path;
+        if (found) {
+            std::vector<int> abstract_path;
+            for (int node = T; node != S; node = parents_[node]) {
+                abstract_path.push_back(node);
+            }
+            abstract_path.push_back(S);
+            std::reverse(abstract_path.begin(), abstract_path.end());
+
+            path.push_back(init);
+            for (std::size_t i = 1; i < abstract_path.size(); i++) {
+                const Point from = path.back();
+                const Point to = cell_of(abstract_path[i]);
+                if (from == to) {
+                    continue;
+                }
+                if (ClusterOf(from.x, from.y) != ClusterOf(to.x, to.y)) {
+                    path.push_back(to);     // inter-cluster edge, a single step
+                } else {
+                    AppendLocalPath(board, from, to, path);
+                }
+            }
+            summary.found = true;
+            summary.cost = path.size() - 1;
+        }
+
+        // reset the scratch state for the next query
+        open_list_.Clear();
+        for (int node : touched_) {
+            g_vals_[node] = kInfinity;
+        }
+        touched_.clear();
+        for (int node : goal_nodes) {
+            goal_link_[node] = kInfinity;
+        }
+        if (result) {
+            *result = summary;
+        }
+        return path;
+    }
+
+  private:
+    struct Edge {
+        int to;
+        int cost;
+    };
+
+    static constexpr char kMagic[4]{'H', 'P', 'A', '1'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr int kInfinity = std::numeric_limits<int>::max();
+    // entrances at least this long get a transition at each end
+    static constexpr int kLongEntrance = 6;
+
+    template <typename T>
+    static void Write( std::ofstream &file, T value ) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    static bool Read( std::ifstream &file, T &value ) {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    int ClusterOf( int x, int y ) const {
+        return (x / cluster_size_) * clusters_y_ + y / cluster_size_;
+    }
+
+    Point CellPoint( int cell ) const { return Point{cell / cols_, cell % cols_}; }
+
+    int AddNode( int x, int y ) {
+        const int cell = x * cols_ + y;
+        auto it = node_of_cell_.find(cell);
+        if (it != node_of_cell_.end()) {
+            return it->second;
+        }
+        const int node = NodeCount();
+        node_cells_.push_back(cell);
+        edges_.emplace_back();
+        node_of_cell_[cell] = node;
+        cluster_nodes_[ClusterOf(x, y)].push_back(node);
+        return node;
+    }
+
+    void AddEdge( int a, int b, int cost ) {
+        for (Edge &edge : edges_[a]) {
+            if (edge.to == b) {
+                if (cost < edge.cost) {
+                    edge.cost = cost;
+                    for (Edge &back : edges_[b]) {
+                        if (back.to == a) {
+                            back.cost = cost;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        edges_[a].push_back(Edge{b, cost});
+        edges_[b].push_back(Edge{a, cost});
+    }
+
+    // adds transitions for the entrance run [begin, end) along a border.
+    // cell(i) returns the pair of cells on either side at position i.
+    template <typename CellPair>
+    void AddEntrance( int begin, int end, CellPair cell ) {
+        std::vector<int> positions;
+        if (end - begin >= kLongEntrance) {
+            positions = {begin, end - 1};
+        } else {
+            positions = {begin + (end - begin - 1) / 2};
+        }
+        for (int i : positions) {
+            const auto [a, b] = cell(i);
+            AddEdge(AddNode(a.x, a.y), AddNode(b.x, b.y), 1);
+        }
+    }
+
+    void BuildEntrances( const GridView &board ) {
+        auto is_free = [&board](int x, int y) { return board(x, y) != State::kObstacle; };
+
+        // borders between horizontally neighboring clusters (columns y - 1 | y)
+        for (int y = cluster_size_; y < cols_; y += cluster_size_) {
+            for (int x0 = 0; x0 < rows_; x0 += cluster_size_) {
+                const int x1 = std::min(x0 + cluster_size_, rows_);
+                int run = -1;
+                for (int x = x0; x <= x1; x++) {
+                    const bool open = x < x1 && is_free(x, y - 1) && is_free(x, y);
+                    if (open && run < 0) {
+                        run = x;
+                    } else if (!open && run >= 0) {
+                        AddEntrance(run, x, [y](int i) {
+                            return std::pair<Point, Point>{Point{i, y - 1}, Point{i, y}};
+                        });
+                        run = -1;
+                    }
+                }
+            }
+        }
+        // borders between vertically neighboring clusters (rows x - 1 | x)
+        for (int x = cluster_size_; x < rows_; x += cluster_size_) {
+            for (int y0 = 0; y0 < cols_; y0 += cluster_size_) {
+                const int y1 = std::min(y0 + cluster_size_, cols_);
+                int run = -1;
+                for (int y = y0; y <= y1; y++) {
+                    const bool open = y < y1 && is_free(x - 1, y) && is_free(x, y);
+                    if (open && run < 0) {
+                        run = y;
+                    } else if (!open && run >= 0) {
+                        AddEntrance(run, y, [x](int i) {
+                            return std::pair<Point, Point>{Point{x - 1, i}, Point{x, i}};
+                        });
+                        run = -1;
+                    }
+                }
+            }
+        }
+    }
+
+    void BuildIntraEdges( const GridView &board ) {
+        ResetScratch();
+        for (const auto &nodes : cluster_nodes_) {
+            for (std::size_t i = 0; i < nodes.size(); i++) {
+                LocalBfs(board, CellPoint(node_cells_[nodes[i]]));
+                for (std::size_t j = i + 1; j < nodes.size(); j++) {
+                    const int d = LocalDistance(CellPoint(node_cells_[nodes[j]]));
+                    if (d != kInfinity) {
+                        AddEdge(nodes[i], nodes[j], d);
+                    }
+                }
+            }
+        }
+    }
+
+    void ResetScratch() {
+        const int local_cells = cluster_size_ * cluster_size_;
+        local_dist_.assign(local_cells, kInfinity);
+        local_parent_.assign(local_cells, -1);
+        local_queue_.reserve(local_cells);
+        g_vals_.assign(NodeCount() + 2, kInfinity);
+        parents_.assign(NodeCount() + 2, -1);
+        goal_link_.assign(NodeCount(), kInfinity);
+        open_list_.Reset(NodeCount() + 2);
+        touched_.clear();
+    }
+
+    // BFS from source that never leaves source's cluster. fills local_dist_ and
+    // local_parent_, indexed relative to the cluster's top-left corner.
+    void LocalBfs( const GridView &board, Point source ) {
+        bfs_x0_ = source.x / cluster_size_ * cluster_size_;
+        bfs_y0_ = source.y / cluster_size_ * cluster_size_;
+        const int x1 = std::min(bfs_x0_ + cluster_size_, rows_);
+        const int y1 = std::min(bfs_y0_ + cluster_size_, cols_);
+        std::fill(local_dist_.begin(), local_dist_.end(), kInfinity);
+
+        const int delta[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+        local_queue_.clear();
+        const int source_local = (source.x - bfs_x0_) * cluster_size_ + source.y - bfs_y0_;
+        local_dist_[source_local] = 0;
+        local_parent_[source_local] = -1;
+        local_queue_.push_back(source_local);
+        for (std::size_t head = 0; head < local_queue_.size(); head++) {
+            const int u = local_queue_[head];
+            const int ux = bfs_x0_ + u / cluster_size_;
+            const int uy = bfs_y0_ + u % cluster_size_;
+            for (auto d : delta) {
+                const int x = ux + d[0];
+                const int y = uy + d[1];
+                if (x < bfs_x0_ || x >= x1 || y < bfs_y0_ || y >= y1 ||
+                    board(x, y) == State::kObstacle) {
+                    continue;
+                }
+                const int v = (x - bfs_x0_) * cluster_size_ + y - bfs_y0_;
+                if (local_dist_[v] == kInfinity) {
+                    local_dist_[v] = local_dist_[u] + 1;
+                    local_parent_[v] = u;
+                    local_queue_.push_back(v);
+                }
+            }
+        }
+    }
+
+    // distance from the last LocalBfs() source, kInfinity if p isn't reachable
+    // inside that cluster
+    int LocalDistance( Point p ) const {
+        if (p.x < bfs_x0_ || p.x >= bfs_x0_ + cluster_size_ ||
+            p.y < bfs_y0_ || p.y >= bfs_y0_ + cluster_size_) {
+            return kInfinity;
+        }
+        return local_dist_[(p.x - bfs_x0_) * cluster_size_ + p.y - bfs_y0_];
+    }
+
+    // appends the cells of a shortest in-cluster path from -> to (without from)
+    void AppendLocalPath( const GridView &board, Point from, Point to, std::vector<Point> &path ) {
+        LocalBfs(board, from);
+        const std::size_t begin = path.size();
+        int v = (to.x - bfs_x0_) * cluster_size_ + to.y - bfs_y0_;
+        for (; local_parent_[v] >= 0; v = local_parent_[v]) {
+            path.push_back(Point{bfs_x0_ + v / cluster_size_, bfs_y0_ + v % cluster_size_});
+        }
+        std::reverse(path.begin() + begin, path.end());
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int cluster_size_ = 16;
+    int clusters_x_ = 0;
+    int clusters_y_ = 0;
+    std::uint64_t board_hash_ = 0;
+
+    // the abstract graph
+    std::vector<int> node_cells_;                   // node -> cell (x * cols + y)
+    std::vector<std::vector<Edge>> edges_;          // node -> neighbors
+    std::vector<std::vector<int>> cluster_nodes_;   // cluster -> its nodes
+    std::unordered_map<int, int> node_of_cell_;
+
+    // scratch state, reused by every query
+    std::vector<int> local_dist_;
+    std::vector<int> local_parent_;
+    std::vector<int> local_queue_;
+    int bfs_x0_ = 0;
+    int bfs_y0_ = 0;
+    std::vector<int> g_vals_;
+    std::vector<int> parents_;
+    std::vector<int> goal_link_;
+    std::vector<int> touched_;
+    OpenList open_list_;
+};
+
+#endif
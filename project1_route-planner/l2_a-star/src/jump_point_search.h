@@ -0,0 +1,215 @@
+#ifndef JUMP_POINT_SEARCH_H
+#define JUMP_POINT_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "open_list.h"
+#include "passability_bitmap.h"
+#include "search_context.h"
+
+/* JUMP POINT SEARCH (4-connected):
+ * On a uniform-cost grid A* spends most of its time on symmetric paths - there
+ * are many equally short orderings of the same horizontal and vertical moves.
+ * JPS only ever expands "jump points" and skips straight over everything in
+ * between, while still finding an optimal path.
+ *
+ * Canonical ordering: whenever a path turns from horizontal to vertical at x
+ * (coming from p) and the cell next to p in the new vertical direction is free,
+ * the two moves can be swapped without changing the length. Repeating that
+ * swap turns any optimal path into one where
+ *   - a vertical move may be followed by a horizontal or vertical move
+ *   - a horizontal move is only followed by a vertical move when it is
+ *     "forced", i.e. the cell next to p on that side is blocked
+ * so it's enough to search canonical paths:
+ *   - horizontal jump: keep going until we hit the goal, an obstacle (dead
+ *     end) or a cell with a forced vertical neighbor (jump point)
+ *   - vertical jump: keep going until we hit the goal, an obstacle, or a cell
+ *     from which a horizontal jump finds a jump point
+ *
+ * Horizontal jumps work on 64 cells at a time using the PassabilityBitmap:
+ * with A = free cells of the row above and A' = the same row shifted by one
+ * cell, A & ~A' marks every cell whose upper neighbor is forced.
+ */
+
+namespace jps {
+
+const int kNoJump = -1;
+
+// jump from column y of row x in direction dy (+1 / -1). returns the column of
+// the jump point, or kNoJump.
+inline int JumpHorizontal( const PassabilityBitmap &free_cells, int x, int y, int dy,
+                           int goal[2] ) {
+    const bool goal_row = goal[0] == x;
+    if (dy > 0) {
+        for (int s = y + 1; s < free_cells.Cols(); s += 64) {
+            const std::uint64_t blocked = ~free_cells.Word64(x, s);
+            std::uint64_t stop = blocked |
+                (free_cells.Word64(x - 1, s) & ~free_cells.Word64(x - 1, s - 1)) |
+                (free_cells.Word64(x + 1, s) & ~free_cells.Word64(x + 1, s - 1));
+            if (goal_row && goal[1] >= s && goal[1] - s < 64) {
+                stop |= std::uint64_t(1) << (goal[1] - s);
+            }
+            if (stop) {
+                const int i = __builtin_ctzll(stop);
+                return ((blocked >> i) & 1) ? kNoJump : s + i;
+            }
+        }
+    } else {
+        for (int s = y - 1; s >= 0; s -= 64) {
+            const std::uint64_t blocked = ~free_cells.WordEndingAt(x, s);
+            std::uint64_t stop = blocked |
+                (free_cells.WordEndingAt(x - 1, s) & ~free_cells.WordEndingAt(x - 1, s + 1)) |
+                (free_cells.WordEndingAt(x + 1, s) & ~free_cells.WordEndingAt(x + 1, s + 1));
+            if (goal_row && goal[1] <= s && s - goal[1] < 64) {
+                stop |= std::uint64_t(1) << (63 - (s - goal[1]));
+            }
+            if (stop) {
+                const int i = 63 - __builtin_clzll(stop);
+                return ((blocked >> i) & 1) ? kNoJump : s - (63 - i);
+            }
+        }
+    }
+    return kNoJump;
+}
+
+// jump from row x of column y in direction dx (+1 / -1). returns the row of the
+// jump point, or kNoJump.
+inline int JumpVertical( const PassabilityBitmap &free_cells, int x, int y, int dx,
+                         int goal[2] ) {
+    while (true) {
+        x += dx;
+        if (x < 0 || x >= free_cells.Rows() || !free_cells.IsFree(x, y)) {
+            return kNoJump;
+        }
+        if (x == goal[0] && y == goal[1]) {
+            return x;
+        }
+        if (JumpHorizontal(free_cells, x, y, 1, goal) != kNoJump ||
+            JumpHorizontal(free_cells, x, y, -1, goal) != kNoJump) {
+            return x;
+        }
+    }
+}
+
+}  // namespace jps
+
+/**
+ * A* over jump points on a read-only board, with all the per-query state in
+ * the context - reused from one query to the next like for FindPath(). The
+ * parent links in the context lead from jump point to jump point. Returns
+ * whether goal was reached; cost and expansions go to result.
+ */
+bool JumpPointSearch( const GridView &board, const PassabilityBitmap &free_cells, Point init,
+                      Point goal, SearchContext &context, SearchResult *result = nullptr ) {
+    SearchResult summary;
+    context.Reset(board.Size());
+    if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+        board(init.x, init.y) == State::kObstacle || board(goal.x, goal.y) == State::kObstacle) {
+        if (result) {
+            *result = summary;
+        }
+        return false;
+    }
+
+    int goal_cell[2]{goal.x, goal.y};
+    OpenList &open_list = context.Open();
+    const int init_id = board.Index(init.x, init.y);
+    const int goal_id = board.Index(goal.x, goal.y);
+    int h_val = Heuristic(init.x, init.y, goal.x, goal.y);
+    context.Set(init_id, 0, -1);
+    open_list.Push(init_id, OpenKey{h_val, h_val});
+
+    // adds the jump point (x, y), reached from current_id
+    auto add_successor = [&](int current_id, int x, int y) {
+        const int id = board.Index(x, y);
+        const int g = context.G(current_id) +
+            Heuristic(board.IndexX(current_id), board.IndexY(current_id), x, y);
+        if (g < context.G(id)) {
+            const int h = Heuristic(x, y, goal.x, goal.y);
+            context.Set(id, g, current_id);
+            open_list.PushOrDecrease(id, OpenKey{g + h, h});
+        }
+    };
+
+    while( !open_list.Empty() ) {
+        const int current_id = open_list.Pop().id;
+        context.Close(current_id);
+        summary.expansions++;
+
+        if (current_id == goal_id) {
+            summary.found = true;
+            summary.cost = context.G(current_id);
+            break;
+        }
+
+        const int x = board.IndexX(current_id);
+        const int y = board.IndexY(current_id);
+        // direction we arrived from (0, 0 for the start)
+        int dx = 0;
+        int dy = 0;
+        const int parent = context.Parent(current_id);
+        if (parent >= 0) {
+            const int px = board.IndexX(parent);
+            const int py = board.IndexY(parent);
+            dx = (x > px) - (x < px);
+            dy = (y > py) - (y < py);
+        }
+
+        // vertical successors: always after a vertical move (or at the start),
+        // after a horizontal move only if forced
+        for (int vx : {-1, 1}) {
+            const bool natural = dy == 0 && dx != -vx;
+            const bool forced = dy != 0 && free_cells.IsFree(x + vx, y) &&
+                                !free_cells.IsFree(x + vx, y - dy);
+            if (natural || forced) {
+                int jx = jps::JumpVertical(free_cells, x, y, vx, goal_cell);
+                if (jx != jps::kNoJump) {
+                    add_successor(current_id, jx, y);
+                }
+            }
+        }
+        // horizontal successors: both ways after a vertical move (or at the
+        // start), straight ahead after a horizontal move
+        for (int vy : {-1, 1}) {
+            if (dy == 0 || dy == vy) {
+                int jy = jps::JumpHorizontal(free_cells, x, y, vy, goal_cell);
+                if (jy != jps::kNoJump) {
+                    add_successor(current_id, x, jy);
+                }
+            }
+        }
+    }
+    if (result) {
+        *result = summary;
+    }
+    return summary.found;
+}
+
+/**
+ * JumpPointSearch() that returns the board with the same marking as
+ * Search(): kPath for expanded (jump point) cells, kClosed for generated
+ * ones. Only the returned Grid is allocated.
+ */
+Grid JumpPointSearch( const GridView &board, const PassabilityBitmap &free_cells,
+                      int init[2], int goal[2], SearchContext &context,
+                      SearchResult *result = nullptr ) {
+    Point start{init[0], init[1]};
+    Point finish{goal[0], goal[1]};
+    if (!JumpPointSearch(board, free_cells, start, finish, context, result)) {
+        cout << "No path found!" << "\n";
+        return Grid{};
+    }
+    return MarkSearch(board, context, start, finish);
+}
+
+// JumpPointSearch() with a context of its own
+Grid JumpPointSearch( const GridView &board, const PassabilityBitmap &free_cells,
+                      int init[2], int goal[2], SearchResult *result = nullptr ) {
+    SearchContext context;
+    return JumpPointSearch(board, free_cells, init, goal, context, result);
+}
+
+#endif
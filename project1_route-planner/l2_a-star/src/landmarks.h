@@ -0,0 +1,340 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "mapped_file.h"
+#include "neighborhood.h"
+#include "open_list.h"
+#include "search_context.h"
+
+/* ALT HEURISTIC (A*, LANDMARKS, TRIANGLE INEQUALITY):
+ * Goldberg & Harrelson. Pick a few landmark cells L and store the exact
+ * distance d(L, v) from each of them to every cell v. Moves cost the same in
+ * both directions, so the triangle inequality gives, for any goal t,
+ *   d(v, t) >= |d(L, t) - d(L, v)|
+ * and the max over all landmarks (and the plain Neighborhood heuristic) is an
+ * admissible and consistent estimate. Unlike Manhattan or octile distance it
+ * knows about the walls: behind a long wall it can be close to the real
+ * distance, and A* expands a corridor instead of a flood.
+ *
+ * Landmarks are picked farthest-first: the first one is the free cell farthest
+ * from an arbitrary free cell, every next one the free cell farthest from all
+ * landmarks so far (cells no landmark reaches count as infinitely far, so
+ * every component of the board gets one as long as there are landmarks left).
+ * Each landmark costs one Dijkstra over the board, the same one that fills in
+ * its distances.
+ *
+ * The distances are stored cell-major, count values per cell, so evaluating
+ * the estimate for a cell reads one cache line. Build() keeps them in memory;
+ * Save() writes them to disk and Open() maps a saved file and reads the
+ * distances in place, without loading or parsing anything. A file belongs to
+ * one board (Matches() compares a hash of it) and one Neighborhood policy.
+ *
+ * The distances are in plain move costs. On a weighted board (terrain.h) the
+ * estimate scaled by the cheapest cell cost is still admissible and consistent.
+ */
+
+/* file layout (host byte order):
+ *   offset  size  field
+ *   0       4     magic "ALT1"
+ *   4       4     version
+ *   8       4     Neighborhood::kId
+ *   12      4     rows
+ *   16      4     cols
+ *   20      4     landmark count
+ *   24      8     board hash
+ *   32      8     table offset from the start of the file (a multiple of 64)
+ *   40      8     table size in bytes = rows * cols * count * 4
+ *   64            count x (i32 x, i32 y) landmark cells
+ *   table offset  u32 distances, count per cell, cells row-major
+ */
+struct LandmarkFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t policy;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t count;
+    std::uint64_t board_hash;
+    std::uint64_t table_offset;
+    std::uint64_t table_size;
+    char padding[16];
+};
+
+static_assert(sizeof(LandmarkFileHeader) == 64, "LandmarkFileHeader must be 64 bytes");
+
+template <typename Neighborhood = FourConnected>
+class Landmarks {
+  public:
+    static constexpr std::uint32_t kUnreachable = std::numeric_limits<std::uint32_t>::max();
+    static constexpr int kMaxCount = 16;
+
+    /* ESTIMATE:
+     * The ALT estimate for one goal (see neighborhood.h), valid as long as the
+     * Landmarks it came from. The landmark distances of goal are looked up
+     * once here, so a call costs count table reads.
+     */
+    class Estimate {
+      public:
+        Estimate( const Landmarks &landmarks, Point goal, int scale )
+            : distances_(landmarks.distances_), cols_(landmarks.cols_), count_(landmarks.count_),
+              goal_(goal), scale_(scale) {
+            const std::uint32_t *goal_distances = landmarks.Distances(goal.x, goal.y);
+            std::copy(goal_distances, goal_distances + count_, goal_distances_);
+        }
+
+        int operator()( int x, int y ) const {
+            const std::uint32_t *distances = distances_ + (std::size_t(x) * cols_ + y) * count_;
+            std::uint32_t best = Neighborhood::Heuristic(x, y, goal_.x, goal_.y);
+            for (int k = 0; k < count_; k++) {
+                // a landmark that doesn't reach both cells says nothing
+                if (distances[k] != kUnreachable && goal_distances_[k] != kUnreachable) {
+                    const std::uint32_t bound = distances[k] > goal_distances_[k]
+                                                    ? distances[k] - goal_distances_[k]
+                                                    : goal_distances_[k] - distances[k];
+                    best = std::max(best, bound);
+                }
+            }
+            return scale_ * static_cast<int>(best);
+        }
+
+      private:
+        const std::uint32_t *distances_;
+        int cols_;
+        int count_;
+        Point goal_;
+        int scale_;
+        std::uint32_t goal_distances_[kMaxCount];
+    };
+
+    Landmarks() = default;
+
+    /**
+     * Picks up to count (at most kMaxCount) landmarks on the board and computes
+     * their distance tables. Fewer if the board has fewer free cells.
+     */
+    void Build( const GridView &board, int count = 8 ) {
+        file_.Close();
+        rows_ = board.Rows();
+        cols_ = board.Cols();
+        board_hash_ = BoardHash(board);
+        points_.clear();
+        count = std::clamp(count, 0, kMaxCount);
+
+        const int size = rows_ * cols_;
+        std::vector<std::vector<std::uint32_t>> tables;
+        std::vector<std::uint32_t> nearest(size, kUnreachable);
+        std::vector<std::uint32_t> scratch;
+        IndexedMinHeap<std::uint32_t> open_list;
+        open_list.Reset(size);
+
+        int seed = -1;
+        for (int id = 0; id < size && seed < 0; id++) {
+            if (board(id / cols_, id % cols_) != State::kObstacle) {
+                seed = id;
+            }
+        }
+        if (seed >= 0 && count > 0) {
+            Dijkstra(board, seed, open_list, scratch);
+        }
+        while (seed >= 0 && static_cast<int>(points_.size()) < count) {
+            // the free cell farthest from all landmarks so far (from seed
+            // for the first one); unreachable cells win
+            int next = -1;
+            std::uint32_t farthest = 0;
+            for (int id = 0; id < size; id++) {
+                if (board(id / cols_, id % cols_) == State::kObstacle) {
+                    continue;
+                }
+                const std::uint32_t d = points_.empty() ? scratch[id] : nearest[id];
+                if (next < 0 || d > farthest) {
+                    next = id;
+                    farthest = d;
+                }
+            }
+            if (!points_.empty() && farthest == 0) {
+                break; // every free cell is a landmark already
+            }
+            points_.push_back(Point{next / cols_, next % cols_});
+            Dijkstra(board, next, open_list, scratch);
+            for (int id = 0; id < size; id++) {
+                nearest[id] = std::min(nearest[id], scratch[id]);
+            }
+            tables.push_back(scratch);
+        }
+
+        count_ = points_.size();
+        table_.assign(std::size_t(size) * count_, kUnreachable);
+        for (int k = 0; k < count_; k++) {
+            for (int id = 0; id < size; id++) {
+                table_[std::size_t(id) * count_ + k] = tables[k][id];
+            }
+        }
+        distances_ = table_.data();
+    }
+
+    bool Save( const std::string &path ) const {
+        LandmarkFileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(header.magic));
+        header.version = kVersion;
+        header.policy = Neighborhood::kId;
+        header.rows = rows_;
+        header.cols = cols_;
+        header.count = count_;
+        header.board_hash = board_hash_;
+        header.table_offset = TableOffset(count_);
+        header.table_size = TableSize();
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (Point p : points_) {
+            const std::int32_t cell[2]{p.x, p.y};
+            file.write(reinterpret_cast<const char *>(cell), sizeof(cell));
+        }
+        const std::vector<char> padding(header.table_offset - sizeof(header) - 8 * count_, 0);
+        file.write(padding.data(), padding.size());
+        file.write(reinterpret_cast<const char *>(distances_), header.table_size);
+        return static_cast<bool>(file);
+    }
+
+    /**
+     * Maps a file written by Save(). The distances stay in the mapping, so this
+     * is O(count) no matter how big the board is. Returns false if the file is
+     * missing, truncated, or was saved for another Neighborhood policy.
+     */
+    bool Open( const std::string &path ) {
+        *this = Landmarks{};
+        LandmarkFileHeader header;
+        if (!file_.Open(path) || file_.Size() < sizeof(header)) {
+            file_.Close();
+            return false;
+        }
+        std::memcpy(&header, file_.Data(), sizeof(header));
+        const bool valid =
+            std::memcmp(header.magic, kMagic, sizeof(header.magic)) == 0 &&
+            header.version == kVersion && header.policy == Neighborhood::kId &&
+            header.count <= kMaxCount && header.table_offset == TableOffset(header.count) &&
+            header.table_size == std::uint64_t(header.rows) * header.cols * header.count * 4 &&
+            header.table_offset + header.table_size <= file_.Size();
+        if (!valid) {
+            file_.Close();
+            return false;
+        }
+        rows_ = header.rows;
+        cols_ = header.cols;
+        count_ = header.count;
+        board_hash_ = header.board_hash;
+        const char *cells = file_.Data() + sizeof(header);
+        for (int k = 0; k < count_; k++) {
+            std::int32_t cell[2];
+            std::memcpy(cell, cells + 8 * k, sizeof(cell));
+            points_.push_back(Point{cell[0], cell[1]});
+        }
+        distances_ = reinterpret_cast<const std::uint32_t *>(file_.Data() + header.table_offset);
+        return true;
+    }
+
+    // true if these landmarks were built for `board`
+    bool Matches( const GridView &board ) const {
+        return board.Rows() == rows_ && board.Cols() == cols_ && BoardHash(board) == board_hash_;
+    }
+
+    int Count() const { return count_; }
+    const std::vector<Point> &Points() const { return points_; }
+
+    // the count distances of cell (x, y), kUnreachable where a landmark can't get there
+    const std::uint32_t *Distances( int x, int y ) const {
+        return distances_ + (std::size_t(x) * cols_ + y) * count_;
+    }
+
+    // the ALT estimate for goal, scale is the cheapest cell cost
+    Estimate For( Point goal, int scale = 1 ) const { return Estimate(*this, goal, scale); }
+
+    /**
+     * FindPath() with the ALT estimate, on the board the landmarks were built
+     * for: false, with an empty path, on a board of another size. Falls back
+     * to the plain heuristic if goal is off the board.
+     */
+    template <typename CellCost = UniformCost>
+    bool FindPath( const GridView &board, Point init, Point goal, SearchContext &context,
+                   vector<Point> &path, SearchResult *result = nullptr,
+                   const CellCost &cell_cost = CellCost{} ) const {
+        if (board.Rows() != rows_ || board.Cols() != cols_) {
+            path.clear();
+            if (result) {
+                *result = SearchResult{};
+            }
+            return false;
+        }
+        if (count_ == 0 || !board.InBounds(goal.x, goal.y)) {
+            return ::FindPath<Neighborhood>(board, init, goal, context, path, result, cell_cost);
+        }
+        return ::FindPath<Neighborhood>(board, init, goal, context, path, result, cell_cost,
+                                        For(goal, cell_cost.MinCost()));
+    }
+
+  private:
+    static constexpr char kMagic[4]{'A', 'L', 'T', '1'};
+    static constexpr std::uint32_t kVersion = 1;
+
+    // the table starts at the first 64-byte boundary after the landmark cells
+    static std::uint64_t TableOffset( std::uint32_t count ) {
+        return (sizeof(LandmarkFileHeader) + 8 * count + 63) / 64 * 64;
+    }
+
+    std::uint64_t TableSize() const {
+        return std::uint64_t(rows_) * cols_ * count_ * sizeof(std::uint32_t);
+    }
+
+    // exact distances from source (a dense x * cols + y index) to every cell
+    void Dijkstra( const GridView &board, int source, IndexedMinHeap<std::uint32_t> &open_list,
+                   std::vector<std::uint32_t> &distances ) const {
+        distances.assign(std::size_t(rows_) * cols_, kUnreachable);
+        open_list.Clear();
+        distances[source] = 0;
+        open_list.Push(source, 0);
+        while (!open_list.Empty()) {
+            const auto [id, distance] = open_list.Pop();
+            const int x = id / cols_;
+            const int y = id % cols_;
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int next_x = x + Neighborhood::kDelta[i][0];
+                const int next_y = y + Neighborhood::kDelta[i][1];
+                if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                    !Neighborhood::CanMove(board, x, y, i)) {
+                    continue;
+                }
+                const int next = next_x * cols_ + next_y;
+                const std::uint32_t next_distance = distance + Neighborhood::kCost[i];
+                if (next_distance < distances[next]) {
+                    distances[next] = next_distance;
+                    open_list.PushOrDecrease(next, next_distance);
+                }
+            }
+        }
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int count_ = 0;
+    std::uint64_t board_hash_ = 0;
+    std::vector<Point> points_;
+    std::vector<std::uint32_t> table_;          // the distances after Build()
+    MappedFile file_;                           // ... or after Open()
+    const std::uint32_t *distances_ = nullptr;
+};
+
+#endif
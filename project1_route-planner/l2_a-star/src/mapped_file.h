@@ -0,0 +1,86 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* MAPPED FILE:
+ * Read-only memory mapping of a whole file (POSIX mmap). The OS pages the file
+ * in as we touch it, so there is no read() into a buffer of our own and no
+ * per-line std::string. The mapping is released by the destructor (RAII), and
+ * like a unique_ptr the object can be moved but not copied.
+ */
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile( const std::string &path ) { Open(path); }
+    ~MappedFile() { Close(); }
+
+    MappedFile( const MappedFile & ) = delete;
+    MappedFile &operator=( const MappedFile & ) = delete;
+
+    MappedFile( MappedFile &&other ) noexcept : data_(other.data_), size_(other.size_) {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    MappedFile &operator=( MappedFile &&other ) noexcept {
+        if (this != &other) {
+            Close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    // returns false if the file can't be opened or is empty
+    bool Open( const std::string &path ) {
+        Close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void *addr = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = static_cast<const char *>(addr);
+                size_ = info.st_size;
+            }
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+        return IsOpen();
+    }
+
+    void Close() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char *>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    // hint that the file will be read front to back (enables read-ahead)
+    void AdviseSequential() const {
+        if (data_ != nullptr) {
+            ::madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const char *Data() const { return data_; }
+    std::size_t Size() const { return size_; }
+
+  private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif
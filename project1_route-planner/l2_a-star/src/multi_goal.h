@@ -0,0 +1,98 @@
+#ifndef MULTI_GOAL_H
+#define MULTI_GOAL_H
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+#include "search_context.h"
+
+/* NEAREST OF SEVERAL GOALS:
+ * "Route to the closest of these 200 charging cells" in one search instead of
+ * one per goal: A* from init that stops at the first goal cell it expands.
+ * The estimate is 0 on every goal, so a goal comes off the open list with
+ * f = its distance, and with a consistent estimate every cell on the way to a
+ * closer goal would have come off first - the first goal expanded is the
+ * nearest reachable one.
+ *
+ * NearestGoalDistance is the smallest Neighborhood heuristic to any of the
+ * goals; a minimum of consistent estimates is consistent. It costs one
+ * heuristic per goal for every generated cell, so beyond kMaxScannedGoals
+ * goals it is the distance to the bounding box of the goals instead - still
+ * no more than the distance to any of them, at a constant cost. Inside the
+ * box that is 0 and the search is a plain multi-target Dijkstra.
+ */
+template <typename Neighborhood = FourConnected>
+class NearestGoalDistance {
+  public:
+    static constexpr int kMaxScannedGoals = 16;
+
+    // goals has to outlive the estimate
+    explicit NearestGoalDistance( const std::vector<Point> &goals, int scale = 1 )
+        : goals_(&goals), scale_(scale), scan_(goals.size() <= kMaxScannedGoals) {
+        for (const Point &goal : goals) {
+            low_ = Point{std::min(low_.x, goal.x), std::min(low_.y, goal.y)};
+            high_ = Point{std::max(high_.x, goal.x), std::max(high_.y, goal.y)};
+        }
+    }
+
+    int operator()( int x, int y ) const {
+        if (scan_) {
+            int best = goals_->empty() ? 0 : std::numeric_limits<int>::max();
+            for (const Point &goal : *goals_) {
+                best = std::min(best, Neighborhood::Heuristic(x, y, goal.x, goal.y));
+            }
+            return scale_ * best;
+        }
+        return scale_ * Neighborhood::Heuristic(x, y, std::clamp(x, low_.x, high_.x),
+                                                std::clamp(y, low_.y, high_.y));
+    }
+
+  private:
+    const std::vector<Point> *goals_;
+    int scale_;
+    bool scan_;     // the minimum over all goals, not the bounding box
+    Point low_{std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+    Point high_{std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+};
+
+/**
+ * Path from init to the nearest reachable cell of goals (both included),
+ * found with a single search: path.back() is the goal it leads to, and the
+ * cost in the result is its distance. Goals off the board or on an obstacle
+ * are ignored. Returns false with an empty path if no goal can be reached.
+ */
+template <typename Neighborhood = FourConnected, typename CellCost = UniformCost, typename Board>
+bool FindNearestPath( const Board &board, Point init, const std::vector<Point> &goals,
+                      SearchContext &context, std::vector<Point> &path,
+                      SearchResult *result = nullptr, const CellCost &cell_cost = CellCost{} ) {
+    path.clear();
+    std::vector<Point> targets;
+    std::vector<int> target_ids;
+    for (const Point &goal : goals) {
+        if (board.InBounds(goal.x, goal.y) && board(goal.x, goal.y) != State::kObstacle) {
+            targets.push_back(goal);
+            target_ids.push_back(board.Index(goal.x, goal.y));
+        }
+    }
+    std::sort(target_ids.begin(), target_ids.end());
+
+    // without a single goal, starting off the board gives up right away
+    const int goal_id = SearchBoardUntil<Neighborhood>(
+        board, targets.empty() ? Point{-1, -1} : init,
+        [&target_ids](int id) {
+            return std::binary_search(target_ids.begin(), target_ids.end(), id);
+        },
+        context, result, cell_cost,
+        NearestGoalDistance<Neighborhood>(targets, cell_cost.MinCost()));
+    if (goal_id == -1) {
+        return false;
+    }
+    ExtractPath(board, context, Point{board.IndexX(goal_id), board.IndexY(goal_id)}, path);
+    return true;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "board.h"
+
+/* NEIGHBORHOOD POLICIES:
+ * How the search moves on the board, passed to SearchBoard() / FindPath() as
+ * a template parameter. A policy is a struct with
+ *   kNeighbors          the number of moves
+ *   kDelta[i]           the {dx, dy} of move i
+ *   kCost[i]            the cost of move i
+ *   Heuristic(...)      an admissible and consistent estimate for these moves
+ *   CanMove(board, ...) whether move i is allowed from a cell, given that
+ *                       its target is a free cell on the board
+ *   kId                 identifies the policy in files that depend on it
+ * Everything is constexpr or static, so the neighbor loop has a fixed trip
+ * count and no runtime dispatch.
+ *
+ * Costs are integers. The 8-connected policies charge 10 for a straight and 14
+ * for a diagonal step (~ 10 * sqrt(2)), i.e. their path costs are in tenths of
+ * a cell. The octile heuristic uses the same two numbers, which keeps it exact
+ * on an empty board and consistent.
+ */
+
+// up, left, down, right - the order Search() has always used
+struct FourConnected {
+    static constexpr int kId = 1;
+    static constexpr int kNeighbors = 4;
+    static constexpr int kDelta[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+    static constexpr int kCost[4]{1, 1, 1, 1};
+
+    // Manhattan distance
+    static int Heuristic( int x1, int y1, int x2, int y2 ) {
+        return std::abs(x2 - x1) + std::abs(y2 - y1);
+    }
+
+    template <typename Board>
+    static bool CanMove( const Board &, int, int, int ) { return true; }
+};
+
+// the four straight moves first, then the diagonals
+struct EightConnected {
+    static constexpr int kId = 2;
+    static constexpr int kNeighbors = 8;
+    static constexpr int kDelta[8][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1},
+                                      {-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+    static constexpr int kStraight = 10;
+    static constexpr int kDiagonal = 14;
+    static constexpr int kCost[8]{kStraight, kStraight, kStraight, kStraight,
+                                  kDiagonal, kDiagonal, kDiagonal, kDiagonal};
+
+    // octile distance: as many diagonal steps as possible, the rest straight
+    static int Heuristic( int x1, int y1, int x2, int y2 ) {
+        const int dx = std::abs(x2 - x1);
+        const int dy = std::abs(y2 - y1);
+        return kStraight * std::max(dx, dy) + (kDiagonal - kStraight) * std::min(dx, dy);
+    }
+
+    // diagonals may squeeze past (and between) obstacles
+    template <typename Board>
+    static bool CanMove( const Board &, int, int, int ) { return true; }
+};
+
+// 8-connected, but a diagonal step needs both cells it passes to be free
+struct EightConnectedNoCornerCutting : EightConnected {
+    static constexpr int kId = 3;
+
+    template <typename Board>
+    static bool CanMove( const Board &board, int x, int y, int i ) {
+        if (i < 4) {
+            return true;
+        }
+        return board(x + kDelta[i][0], y) != State::kObstacle &&
+               board(x, y + kDelta[i][1]) != State::kObstacle;
+    }
+};
+
+/* CELL COSTS:
+ * What it costs to enter a cell, as a factor on the cost of the move that
+ * enters it. UniformCost is the plain board, terrain.h has per-cell costs.
+ * The heuristic is scaled by MinCost(): no cell is cheaper than that, so the
+ * scaled estimate stays admissible and consistent.
+ */
+struct UniformCost {
+    int operator()( int ) const { return 1; }
+    int MinCost() const { return 1; }
+};
+
+/* ESTIMATES:
+ * The h-value of a cell for one particular goal, as a functor int(x, y).
+ * GoalDistance is the Neighborhood heuristic scaled by the cheapest cell cost,
+ * what the search uses unless it is handed a better one (see landmarks.h).
+ */
+template <typename Neighborhood>
+struct GoalDistance {
+    Point goal;
+    int scale = 1;
+
+    int operator()( int x, int y ) const {
+        return scale * Neighborhood::Heuristic(x, y, goal.x, goal.y);
+    }
+};
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef OPEN_LIST_H
+#define OPEN_LIST_H
+
+#include <vector>
+
+/* OPEN LIST:
+ * An indexed binary min-heap. Every node that can ever be on the open list is
+ * identified by an integer id in [0, capacity) - for a grid that's just the
+ * row-major cell index (x * cols + y). Next to the heap we keep a "position"
+ * table that maps an id to its slot in the heap, which is what gives us an O(1)
+ * Contains() and an O(log n) DecreaseKey().
+ *
+ * CellSort() re-sorts the entire open list every time we want to pop a single
+ * node (O(n log n) per pop). With the heap, Push(), Pop() and DecreaseKey() are
+ * all O(log n).
+ */
+
+// same ordering as Compare(): the node with the lowest f = g + h comes first.
+// ties are broken on the lower h-value, i.e. the node closer to the goal.
+// Cost is int, or std::int64_t for searches whose costs can outgrow an int.
+template <typename Cost>
+struct BasicOpenKey {
+    Cost f;
+    Cost h;
+};
+
+template <typename Cost>
+inline bool operator<( const BasicOpenKey<Cost> &a, const BasicOpenKey<Cost> &b ) {
+    return a.f < b.f || (a.f == b.f && a.h < b.h);
+}
+
+using OpenKey = BasicOpenKey<int>;
+
+template <typename Key>
+class IndexedMinHeap {
+  public:
+    struct Entry {
+        int id;
+        Key key;
+    };
+
+    explicit IndexedMinHeap( int capacity = 0 ) : position_(capacity, kNotInHeap) {}
+
+    // drops all entries and (re)sizes the id range to [0, capacity)
+    void Reset( int capacity ) {
+        heap_.clear();
+        position_.assign(capacity, kNotInHeap);
+    }
+
+    // drops all entries, keeping the id range. O(size), not O(capacity)
+    void Clear() {
+        for (const Entry &entry : heap_) {
+            position_[entry.id] = kNotInHeap;
+        }
+        heap_.clear();
+    }
+
+    bool Empty() const { return heap_.empty(); }
+    int Size() const { return static_cast<int>(heap_.size()); }
+    int Capacity() const { return static_cast<int>(position_.size()); }
+    bool Contains( int id ) const { return position_[id] != kNotInHeap; }
+
+    const Entry &Top() const { return heap_.front(); }
+    const Key &KeyOf( int id ) const { return heap_[position_[id]].key; }
+
+    // id must not already be on the heap
+    void Push( int id, Key key ) {
+        heap_.push_back(Entry{id, key});
+        position_[id] = Size() - 1;
+        SiftUp(Size() - 1);
+    }
+
+    // key must not be larger than the current key of id
+    void DecreaseKey( int id, Key key ) {
+        heap_[position_[id]].key = key;
+        SiftUp(position_[id]);
+    }
+
+    // pushes id, or lowers its key if it is already on the heap and key is
+    // better. returns true if the heap changed.
+    bool PushOrDecrease( int id, Key key ) {
+        if (!Contains(id)) {
+            Push(id, key);
+            return true;
+        }
+        if (key < KeyOf(id)) {
+            DecreaseKey(id, key);
+            return true;
+        }
+        return false;
+    }
+
+    // sets the key of id, whether it goes up or down
+    void Update( int id, Key key ) {
+        const int i = position_[id];
+        heap_[i].key = key;
+        SiftUp(i);
+        SiftDown(position_[id]);
+    }
+
+    void Remove( int id ) {
+        const int i = position_[id];
+        position_[id] = kNotInHeap;
+        const Entry last = heap_.back();
+        heap_.pop_back();
+        if (i < Size()) {
+            Place(i, last);
+            SiftUp(i);
+            SiftDown(position_[last.id]);
+        }
+    }
+
+    // the i-th entry in heap order, i in [0, Size()) - for walking all entries
+    const Entry &At( int i ) const { return heap_[i]; }
+
+    Entry Pop() {
+        const Entry top = heap_.front();
+        Remove(top.id);
+        return top;
+    }
+
+  private:
+    static constexpr int kNotInHeap = -1;
+
+    void Place( int i, const Entry &entry ) {
+        heap_[i] = entry;
+        position_[entry.id] = i;
+    }
+
+    void SiftUp( int i ) {
+        const Entry entry = heap_[i];
+        while (i > 0) {
+            const int parent = (i - 1) / 2;
+            if (!(entry.key < heap_[parent].key)) {
+                break;
+            }
+            Place(i, heap_[parent]);
+            i = parent;
+        }
+        Place(i, entry);
+    }
+
+    void SiftDown( int i ) {
+        const Entry entry = heap_[i];
+        const int size = Size();
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && heap_[child + 1].key < heap_[child].key) {
+                child++;
+            }
+            if (!(heap_[child].key < entry.key)) {
+                break;
+            }
+            Place(i, heap_[child]);
+            i = child;
+        }
+        Place(i, entry);
+    }
+
+    std::vector<Entry> heap_;
+    std::vector<int> position_;     // id -> slot in heap_, or kNotInHeap
+};
+
+using OpenList = IndexedMinHeap<OpenKey>;
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef PASSABILITY_BITMAP_H
+#define PASSABILITY_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "board.h"
+
+/* PASSABILITY BITMAP:
+ * One bit per cell, 1 = passable (anything but kObstacle). That's 8x less
+ * memory than the State grid, and a whole neighborhood can be read with a few
+ * shifts and masks instead of a bounds check and a compare per neighbor.
+ *
+ * To get rid of the bounds checks the bitmap has a guard border of blocked
+ * cells: stored row x + 1 holds board row x, and inside a row board column y
+ * sits at bit y + 1. Every stored row is also padded with at least one spare
+ * word, so reading the 3-bit window around any cell never leaves the row.
+ */
+
+// neighbor order of the bits returned by NeighborMask4() / NeighborMask8().
+// the first four match the delta table of ExpandNeighbors().
+const int kBitmapDelta4[4][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+const int kBitmapDelta8[8][2]{{-1, 0}, {0, -1}, {1, 0}, {0, 1},
+                              {-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+
+class PassabilityBitmap {
+  public:
+    PassabilityBitmap() = default;
+
+    template <typename Board>
+    explicit PassabilityBitmap( const Board &board ) {
+        Resize(board.Rows(), board.Cols());
+        for (int x = 0; x < rows_; x++) {
+            const State *row = board.Row(x);
+            std::uint64_t *out = Row(x + 1);
+            // gather 64 cells into a word before storing it
+            for (int y0 = 0; y0 < cols_; y0 += 64) {
+                std::uint64_t free = 0;
+                const int n = cols_ - y0 < 64 ? cols_ - y0 : 64;
+                for (int i = 0; i < n; i++) {
+                    free |= std::uint64_t(row[y0 + i] != State::kObstacle) << i;
+                }
+                out[y0 / 64] |= free << 1;
+                out[y0 / 64 + 1] |= free >> 63;
+            }
+        }
+    }
+
+    // from a packed obstacle bitmap (1 = kObstacle, e.g. the payload of a kBit1
+    // binary board) with `stride` words per row. works a word at a time.
+    PassabilityBitmap( const std::uint64_t *obstacle_bits, int rows, int cols, int stride ) {
+        Resize(rows, cols);
+        for (int x = 0; x < rows_; x++) {
+            const std::uint64_t *in = obstacle_bits + std::uint64_t(x) * stride;
+            std::uint64_t *out = Row(x + 1);
+            for (int i = 0; i < stride; i++) {
+                std::uint64_t free = ~in[i];
+                const int valid = cols_ - 64 * i;
+                if (valid <= 0) {
+                    free = 0;
+                } else if (valid < 64) {
+                    free &= (std::uint64_t(1) << valid) - 1;
+                }
+                // shift everything one bit up to make room for the guard column
+                out[i] |= free << 1;
+                out[i + 1] |= free >> 63;
+            }
+        }
+    }
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+
+    // bytes used by the bitmap (including the guard border)
+    std::size_t Bytes() const { return words_.size() * sizeof(std::uint64_t); }
+
+    bool IsFree( int x, int y ) const {
+        return (Row(x + 1)[(y + 1) / 64] >> ((y + 1) % 64)) & 1;
+    }
+
+    void Set( int x, int y, bool free ) {
+        std::uint64_t &word = Row(x + 1)[(y + 1) / 64];
+        const std::uint64_t bit = std::uint64_t(1) << ((y + 1) % 64);
+        word = free ? (word | bit) : (word & ~bit);
+    }
+
+    // bit i is set if the neighbor (x, y) + kBitmapDelta4[i] is free. cells off
+    // the board count as blocked.
+    unsigned NeighborMask4( int x, int y ) const {
+        return Mask4(Window3(x, y), Window3(x + 1, y), Window3(x + 2, y));
+    }
+
+    // bit i is set if the neighbor (x, y) + kBitmapDelta8[i] is free
+    unsigned NeighborMask8( int x, int y ) const {
+        const unsigned above = Window3(x, y);
+        const unsigned middle = Window3(x + 1, y);
+        const unsigned below = Window3(x + 2, y);
+        return Mask4(above, middle, below) |
+               ((above & 1) << 4) |           // {-1,-1}
+               ((below & 1) << 5) |           // { 1,-1}
+               (((below >> 2) & 1) << 6) |    // { 1, 1}
+               (((above >> 2) & 1) << 7);     // {-1, 1}
+    }
+
+    // first free column >= y in row x, or Cols() if there is none
+    int NextFree( int x, int y ) const { return Scan(x, y, 0); }
+
+    // first blocked column >= y in row x, or Cols() if there is none
+    int NextBlocked( int x, int y ) const { return Scan(x, y, ~std::uint64_t(0)); }
+
+    // number of free cells in row x
+    int CountFree( int x ) const {
+        int count = 0;
+        const std::uint64_t *row = Row(x + 1);
+        for (int i = 0; i < words_per_row_; i++) {
+            count += __builtin_popcountll(row[i]);
+        }
+        return count;
+    }
+
+    // 64 cells of row x, bit i = column y + i. x may be -1 or Rows() and y
+    // may be -1 (the guard border); columns past the board read as blocked.
+    std::uint64_t Word64( int x, int y ) const {
+        const std::uint64_t *row = Row(x + 1);
+        const int i = (y + 1) / 64;
+        const int shift = (y + 1) % 64;
+        return (row[i] >> shift) | ((row[i + 1] << 1) << (63 - shift));
+    }
+
+    // 64 cells of row x that end at column y, bit 63 = column y. columns left
+    // of the board read as blocked.
+    std::uint64_t WordEndingAt( int x, int y ) const {
+        if (y - 63 >= -1) {
+            return Word64(x, y - 63);
+        }
+        return Word64(x, -1) << (62 - y);
+    }
+
+  private:
+    void Resize( int rows, int cols ) {
+        rows_ = rows;
+        cols_ = cols;
+        // guard column + cols + one spare word for Window3()
+        words_per_row_ = (cols + 1) / 64 + 2;
+        words_.assign(std::size_t(rows + 2) * words_per_row_, 0);
+    }
+
+    std::uint64_t *Row( int stored_x ) {
+        return words_.data() + std::size_t(stored_x) * words_per_row_;
+    }
+    const std::uint64_t *Row( int stored_x ) const {
+        return words_.data() + std::size_t(stored_x) * words_per_row_;
+    }
+
+    static unsigned Mask4( unsigned above, unsigned middle, unsigned below ) {
+        return ((above >> 1) & 1) |           // {-1, 0}
+               ((middle & 1) << 1) |          // { 0,-1}
+               (((below >> 1) & 1) << 2) |    // { 1, 0}
+               (((middle >> 2) & 1) << 3);    // { 0, 1}
+    }
+
+    // bits of stored row `stored_x` for board columns y-1, y, y+1
+    unsigned Window3( int stored_x, int y ) const {
+        const std::uint64_t *row = Row(stored_x);
+        const int i = y / 64;       // board column y - 1 is stored bit y
+        const int shift = y % 64;
+        // (hi << 1) << (63 - shift) is hi << (64 - shift), minus the UB at shift 0
+        const std::uint64_t bits = (row[i] >> shift) | ((row[i + 1] << 1) << (63 - shift));
+        return bits & 7;
+    }
+
+    // first column >= y whose bit differs from `skip` (all 0s or all 1s)
+    int Scan( int x, int y, std::uint64_t skip ) const {
+        const std::uint64_t *row = Row(x + 1);
+        int bit = y + 1;
+        int i = bit / 64;
+        std::uint64_t word = (row[i] ^ skip) & (~std::uint64_t(0) << (bit % 64));
+        while (word == 0) {
+            if (++i >= words_per_row_) {
+                return cols_;
+            }
+            word = row[i] ^ skip;
+        }
+        const int column = 64 * i + __builtin_ctzll(word) - 1;
+        return column < cols_ ? column : cols_;
+    }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int words_per_row_ = 0;
+    std::vector<std::uint64_t> words_;
+};
+
+#endif
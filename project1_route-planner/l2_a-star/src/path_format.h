@@ -0,0 +1,154 @@
+#ifndef PATH_FORMAT_H
+#define PATH_FORMAT_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "board.h"
+
+/* PATH FORMATS:
+ * FindPath() returns the route cell by cell. Most consumers want something
+ * smaller than that, and none of them want the whole board:
+ *   - waypoints: init, every cell where the route turns, and goal. Consecutive
+ *     waypoints share a row, a column or a diagonal.
+ *   - moves: the route as a run-length encoded string of steps, e.g. "D4R3U1"
+ *     = 4 steps down (+x), 3 right (+y), 1 up (-x). L is left (-y). The
+ *     diagonal steps of 8-connected routes are the keys around S on a
+ *     keyboard: Q up-left, E up-right, Z down-left, C down-right.
+ * Both convert back into the full cell path. DrawPath() is the opt-in mode
+ * that still paints a route into a copy of the board.
+ */
+
+// direction letter of a single step
+inline char MoveLetter( Point from, Point to ) {
+    const char letters[3][3]{{'Q', 'U', 'E'}, {'L', '?', 'R'}, {'Z', 'D', 'C'}};
+    return letters[(to.x > from.x) - (to.x < from.x) + 1][(to.y > from.y) - (to.y < from.y) + 1];
+}
+
+// init, the turning points and goal of a cell path
+std::vector<Point> Waypoints( const std::vector<Point> &path ) {
+    std::vector<Point> waypoints;
+    if (path.empty()) {
+        return waypoints;
+    }
+    waypoints.push_back(path.front());
+    for (std::size_t i = 1; i + 1 < path.size(); i++) {
+        if (MoveLetter(path[i - 1], path[i]) != MoveLetter(path[i], path[i + 1])) {
+            waypoints.push_back(path[i]);
+        }
+    }
+    if (path.size() > 1) {
+        waypoints.push_back(path.back());
+    }
+    return waypoints;
+}
+
+// the cell path through a list of waypoints, each in a straight or diagonal
+// line from the one before
+std::vector<Point> ExpandWaypoints( const std::vector<Point> &waypoints ) {
+    std::vector<Point> path;
+    if (waypoints.empty()) {
+        return path;
+    }
+    path.push_back(waypoints.front());
+    for (std::size_t i = 1; i < waypoints.size(); i++) {
+        const Point to = waypoints[i];
+        Point at = path.back();
+        const int dx = (to.x > at.x) - (to.x < at.x);
+        const int dy = (to.y > at.y) - (to.y < at.y);
+        while (at != to) {
+            at = Point{at.x + dx, at.y + dy};
+            path.push_back(at);
+        }
+    }
+    return path;
+}
+
+// run-length encoded moves of a cell path, "" for a path of one cell
+std::string EncodeMoves( const std::vector<Point> &path ) {
+    std::string moves;
+    std::size_t i = 1;
+    while (i < path.size()) {
+        const char letter = MoveLetter(path[i - 1], path[i]);
+        int run = 0;
+        while (i < path.size() && MoveLetter(path[i - 1], path[i]) == letter) {
+            run++;
+            i++;
+        }
+        moves += letter;
+        moves += std::to_string(run);
+    }
+    return moves;
+}
+
+// steps DecodeMoves() accepts unless told otherwise: a route across a
+// 4096 x 4096 board that visits every cell
+const std::size_t kMaxDecodedSteps = std::size_t(1) << 24;
+
+/**
+ * The cell path that starts at init and follows moves. Empty if moves is
+ * malformed or has more than max_steps steps in all - e.g. pass the number of
+ * cells of the board, no route without repeated cells is longer - so a corrupt
+ * string can't make it allocate without bound.
+ */
+std::vector<Point> DecodeMoves( Point init, const std::string &moves,
+                                std::size_t max_steps = kMaxDecodedSteps ) {
+    std::vector<Point> path{init};
+    std::size_t steps = 0;
+    std::size_t i = 0;
+    while (i < moves.size()) {
+        int dx = 0;
+        int dy = 0;
+        switch (moves[i]) {
+            case 'D': dx = 1; break;
+            case 'U': dx = -1; break;
+            case 'R': dy = 1; break;
+            case 'L': dy = -1; break;
+            case 'Q': dx = -1; dy = -1; break;
+            case 'E': dx = -1; dy = 1; break;
+            case 'Z': dx = 1; dy = -1; break;
+            case 'C': dx = 1; dy = 1; break;
+            default: return {};
+        }
+        // the digits of the run, stopping as soon as it is over the limit
+        std::size_t run = 0;
+        std::size_t digit = i + 1;
+        for (; digit < moves.size() && moves[digit] >= '0' && moves[digit] <= '9'; digit++) {
+            const std::size_t value = moves[digit] - '0';
+            const std::size_t limit = max_steps - steps;
+            if (value > limit || run > (limit - value) / 10) {
+                return {};
+            }
+            run = 10 * run + value;
+        }
+        if (digit == i + 1 || run == 0) {
+            return {};
+        }
+        i = digit;
+        steps += run;
+        for (std::size_t step = 0; step < run; step++) {
+            path.push_back(Point{path.back().x + dx, path.back().y + dy});
+        }
+    }
+    return path;
+}
+
+/**
+ * Opt-in board output: a copy of the board with the route painted in - kPath
+ * on the cells of the path, kStart and kFinish on its ends.
+ */
+Grid DrawPath( const GridView &board, const std::vector<Point> &path ) {
+    Grid grid(board);
+    if (path.empty()) {
+        return grid;
+    }
+    for (Point p : path) {
+        grid(p.x, p.y) = State::kPath;
+    }
+    grid(path.front().x, path.front().y) = State::kStart;
+    grid(path.back().x, path.back().y) = State::kFinish;
+    return grid;
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef ROUTE_PLANNER_H
+#define ROUTE_PLANNER_H
+
+#include "bidirectional_search.h"
+#include "board.h"
+#include "grid_search.h"
+#include "jump_point_search.h"
+#include "passability_bitmap.h"
+
+/* ROUTE PLANNER:
+ * One entry point for all the search variants that work on a Grid. Every mode
+ * returns an optimal path length on the 4-connected, uniform-cost board model
+ * of Search().
+ */
+
+enum class SearchMode {kAStar, kJumpPoint, kBidirectional};
+
+Grid Search( const Grid &grid, int init[2], int goal[2], SearchMode mode,
+             SearchResult *result = nullptr ) {
+    switch (mode) {
+        case SearchMode::kJumpPoint: {
+            PassabilityBitmap free_cells(grid);
+            return JumpPointSearch(grid.View(), free_cells, init, goal, result);
+        }
+        case SearchMode::kBidirectional:
+            return BidirectionalSearch(grid.View(), init, goal, result);
+        default: return Search(grid, init, goal, result);
+    }
+}
+
+#endif
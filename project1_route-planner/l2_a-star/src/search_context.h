@@ -0,0 +1,109 @@
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "open_list.h"
+#include "search_stats.h"
+
+/* SEARCH CONTEXT:
+ * The per-query scratch state of an A* search - g-values, parent links, the
+ * closed set and the open list - kept outside of the board. The board can then
+ * be shared read-only (e.g. between threads), and a context can be reused for
+ * the next query instead of allocating everything again.
+ *
+ * GENERATION STAMPS:
+ * Every cell carries the generation (query number) in which it was last
+ * written. Reset() just bumps the current generation, which turns every old
+ * g-value, parent link and closed flag into "never touched" at once - nothing
+ * is cleared or copied. Only the open list still has to drop its leftover
+ * entries, which costs no more than the search that left them there.
+ *
+ * After 2^32 - 1 queries the stamps wrap around; that one Reset() clears the
+ * stamps for real.
+ *
+ * Stats() describes the last search that ran on the context (see
+ * search_stats.h); Reset() starts them over.
+ *
+ * COST TYPE:
+ * g-values and open-list keys are ints, which is plenty for the plain board.
+ * Weighted searches (see terrain.h) can outgrow that and use a
+ * WideSearchContext, with 64-bit costs at 8 more bytes per cell.
+ */
+template <typename Cost>
+class BasicSearchContext {
+  public:
+    using Key = BasicOpenKey<Cost>;
+    using Heap = IndexedMinHeap<Key>;
+
+    static constexpr Cost kInfinity = std::numeric_limits<Cost>::max();
+
+    // makes room for node ids in [0, size) and forgets the previous search
+    void Reset( int size ) {
+        if (size != Size()) {
+            nodes_.assign(size, Node{});
+            open_list_.Reset(size);
+            generation_ = 0;
+        } else {
+            open_list_.Clear();
+        }
+        if (++generation_ == 0) {
+            for (Node &node : nodes_) {
+                node.seen = node.closed = 0;
+            }
+            generation_ = 1;
+        }
+        stats_ = SearchStats{};
+    }
+
+    int Size() const { return static_cast<int>(nodes_.size()); }
+
+    // kInfinity / -1 for cells the current search hasn't reached
+    Cost G( int id ) const { return Seen(id) ? nodes_[id].g : kInfinity; }
+    int Parent( int id ) const { return Seen(id) ? nodes_[id].parent : -1; }
+    bool Seen( int id ) const { return nodes_[id].seen == generation_; }
+
+    void Set( int id, Cost g, int parent ) {
+        Node &node = nodes_[id];
+        node.seen = generation_;
+        node.g = g;
+        node.parent = parent;
+    }
+
+    // closed = expanded by the current search
+    bool Closed( int id ) const { return nodes_[id].closed == generation_; }
+    void Close( int id ) { nodes_[id].closed = generation_; }
+
+    Heap &Open() { return open_list_; }
+
+    SearchStats &Stats() { return stats_; }
+    const SearchStats &Stats() const { return stats_; }
+
+    // bytes of per-query state with open_entries nodes on the open list
+    std::size_t MemoryBytes( int open_entries ) const {
+        return nodes_.size() * sizeof(Node) + open_list_.Capacity() * sizeof(int) +
+               std::size_t(open_entries) * sizeof(typename Heap::Entry);
+    }
+
+  private:
+    // all the state of one cell side by side, so a lookup touches one cache line
+    struct Node {
+        std::uint32_t seen = 0;
+        std::uint32_t closed = 0;
+        Cost g = kInfinity;
+        int parent = -1;
+    };
+
+    std::vector<Node> nodes_;
+    std::uint32_t generation_ = 0;
+    Heap open_list_;
+    SearchStats stats_;
+};
+
+using SearchContext = BasicSearchContext<int>;
+using WideSearchContext = BasicSearchContext<std::int64_t>;
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/* SEARCH STATS:
+ * What one SearchBoard() call did, for attributing latency after the fact:
+ * SearchContext::Stats() holds the numbers of the last search that ran on the
+ * context.
+ *
+ * Counting is a few increments per expansion. Timing every expansion would
+ * cost more than the expansion itself, so only every kSampleEvery-th one is
+ * timed (the open-list pop, generating the neighbors, and pushing them) and
+ * the sampled times are scaled up to all expansions. The cost of reading the
+ * clock is taken off every lap, but a timed expansion still runs a bit slower
+ * than the others, so where the estimates add up to more than the search took
+ * they are scaled down to fit. The total latency is measured exactly.
+ *
+ * Build with -DSEARCH_STATS=0 to compile all of it out; the stats then stay 0.
+ */
+
+#ifndef SEARCH_STATS
+#define SEARCH_STATS 1
+#endif
+
+constexpr bool kSearchStats = SEARCH_STATS != 0;
+
+struct SearchStats {
+    static constexpr int kSampleEvery = 64;
+
+    long long expansions = 0;       // cells popped off the open list
+    long long pushes = 0;           // cells put on the open list
+    long long reopens = 0;          // open cells reached again by a cheaper route
+    int peak_open = 0;              // largest open list size
+    std::size_t peak_memory = 0;    // bytes of per-query state: the context, the open list at its peak
+    double neighbor_ms = 0;         // generating and checking neighbors (sampled)
+    double open_list_ms = 0;        // popping and pushing (sampled)
+    double total_ms = 0;            // the whole search
+
+    static std::int64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // starts timing expansion number `expansion` if it is one of the samples
+    void StartSample( long long expansion ) {
+        sampling_ = expansion % kSampleEvery == 0;
+        if (sampling_) {
+            samples_++;
+            mark_ = Now();
+        }
+    }
+
+    // adds the time since the last mark to one of the sampled buckets
+    void LapNeighbors() { Lap(neighbor_ns_); }
+    void LapOpenList() { Lap(open_list_ns_); }
+
+    // turns the samples into estimates for all expansions
+    void Finish( std::int64_t start ) {
+        total_ms = (Now() - start) / 1e6;
+        double scale = samples_ > 0 ? double(expansions) / samples_ / 1e6 : 0;
+        const double sampled_ms = (neighbor_ns_ + open_list_ns_) * scale;
+        if (sampled_ms > total_ms) {
+            scale *= total_ms / sampled_ms;
+        }
+        neighbor_ms = neighbor_ns_ * scale;
+        open_list_ms = open_list_ns_ * scale;
+    }
+
+  private:
+    // the shortest time between two clock reads, measured once
+    static std::int64_t ClockCost() {
+        static const std::int64_t cost = [] {
+            std::int64_t best = std::numeric_limits<std::int64_t>::max();
+            for (int i = 0; i < 64; i++) {
+                const std::int64_t before = Now();
+                best = std::min(best, Now() - before);
+            }
+            return best;
+        }();
+        return cost;
+    }
+
+    void Lap( std::int64_t &bucket ) {
+        if (sampling_) {
+            const std::int64_t now = Now();
+            bucket += std::max<std::int64_t>(0, now - mark_ - ClockCost());
+            mark_ = now;
+        }
+    }
+
+    bool sampling_ = false;
+    long long samples_ = 0;
+    std::int64_t mark_ = 0;
+    std::int64_t neighbor_ns_ = 0;
+    std::int64_t open_list_ns_ = 0;
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+#include "search_context.h"
+
+/* TERRAIN:
+ * A weighted board: every cell has an integer cost of 1..255 for entering it,
+ * or 0 if it is blocked. The costs are one byte per cell in their own array,
+ * next to a Grid of States that uses the same indexing. Blocked cells are
+ * kObstacle in that Grid, so everything that only needs passability (the
+ * neighbor checks, the GridView based code) works off View() unchanged.
+ *
+ * A* on a Terrain charges move cost * cell cost for every step, i.e. on the
+ * 4-connected board the path cost is the sum of the costs of all the cells
+ * entered after init.
+ *
+ * A g-value is the cost of a path without repeated cells, so it is at most
+ * cells * kMaxStepCost * MaxCost(), and the estimate adds at most
+ * (rows + cols) * kMaxStepCost * MaxCost(). With every cell at 255 that passes
+ * INT_MAX at about 600k cells (775 x 775), so FindPath() on a Terrain keeps g
+ * and f in 64 bits (WideSearchContext, see search_context.h), which no board
+ * with int cell ids can overflow. Fits() tells whether a plain SearchContext
+ * would do, e.g. for FindPath() on View() with a TerrainCost.
+ */
+class Terrain {
+  public:
+    static constexpr std::uint8_t kBlocked = 0;
+    static constexpr int kMaxCost = 255;
+    static constexpr int kMaxStepCost = EightConnected::kDiagonal; // of every Neighborhood
+
+    Terrain() = default;
+
+    Terrain( int rows, int cols, std::uint8_t cost = 1 )
+        : states_(rows, cols, cost == kBlocked ? State::kObstacle : State::kEmpty),
+          costs_(states_.Size(), cost) {
+        cost_counts_[cost] = rows * cols;
+    }
+
+    // cost 1 for the free cells of a plain board, obstacles are blocked
+    explicit Terrain( const GridView &board ) : Terrain(board.Rows(), board.Cols()) {
+        for (int x = 0; x < Rows(); x++) {
+            for (int y = 0; y < Cols(); y++) {
+                if (board(x, y) == State::kObstacle) {
+                    SetCost(x, y, kBlocked);
+                }
+            }
+        }
+    }
+
+    int Rows() const { return states_.Rows(); }
+    int Cols() const { return states_.Cols(); }
+    int Size() const { return states_.Size(); }
+    bool Empty() const { return states_.Empty(); }
+    bool InBounds( int x, int y ) const { return states_.InBounds(x, y); }
+    int Index( int x, int y ) const { return states_.Index(x, y); }
+
+    int Cost( int x, int y ) const { return costs_[Index(x, y)]; }
+
+    // 0 (kBlocked) makes the cell an obstacle
+    void SetCost( int x, int y, std::uint8_t cost ) {
+        std::uint8_t &cell = costs_[Index(x, y)];
+        cost_counts_[cell]--;
+        cost_counts_[cost]++;
+        cell = cost;
+        states_(x, y) = cost == kBlocked ? State::kObstacle : State::kEmpty;
+    }
+
+    // cheapest cell that isn't blocked, 1 if there is none
+    int MinCost() const {
+        for (int cost = 1; cost <= kMaxCost; cost++) {
+            if (cost_counts_[cost] > 0) {
+                return cost;
+            }
+        }
+        return 1;
+    }
+
+    // most expensive cell that isn't blocked, 1 if there is none
+    int MaxCost() const {
+        for (int cost = kMaxCost; cost > 1; cost--) {
+            if (cost_counts_[cost] > 0) {
+                return cost;
+            }
+        }
+        return 1;
+    }
+
+    // upper bound on any g- or f-value of a search on the terrain, see above
+    std::int64_t MaxSearchCost() const {
+        return (std::int64_t(Size()) + Rows() + Cols()) * kMaxStepCost * MaxCost();
+    }
+
+    // whether the search fits int costs
+    bool Fits() const { return MaxSearchCost() <= std::numeric_limits<int>::max(); }
+
+    GridView View() const { return states_.View(); }
+    const std::uint8_t *Costs() const { return costs_.data(); }
+
+  private:
+    Grid states_;
+    std::vector<std::uint8_t> costs_;
+    std::array<int, kMaxCost + 1> cost_counts_{}; // number of cells per cost
+};
+
+/**
+ * CellCost (see neighborhood.h) of a Terrain, which must outlive it.
+ */
+class TerrainCost {
+  public:
+    explicit TerrainCost( const Terrain &terrain )
+        : costs_(terrain.Costs()), min_cost_(terrain.MinCost()) {}
+
+    int operator()( int id ) const { return costs_[id]; }
+    int MinCost() const { return min_cost_; }
+
+  private:
+    const std::uint8_t *costs_;
+    int min_cost_;
+};
+
+// ParseLine() that keeps the numbers, e.g. "1,0,5," -> {1, 0, 5}
+vector<int> ParseCostLine( std::string line ) {
+    std::istringstream sline(line);
+    int n;
+    char c;
+    vector<int> row;
+
+    while (sline >> n >> c && c == ',') {
+        row.push_back(n);
+    }
+    return row;
+}
+
+/**
+ * Reads a .board file as a Terrain: every number is the cost of its cell,
+ * and `blocked` marks blocked cells. With a sentinel other than 0, a 0 is not
+ * a valid cost. Ragged rows or costs outside 1..255 give an empty Terrain.
+ */
+Terrain ReadTerrainFile( std::string path, int blocked = 0 ) {
+    std::ifstream board_file( path );
+    vector<int> cells;
+    int rows = 0;
+    int cols = 0;
+
+    if (board_file) {
+        std::string line;
+        while (getline(board_file, line)) {
+            vector<int> row = ParseCostLine( line );
+            if (rows == 0) {
+                cols = row.size();
+            } else if (static_cast<int>(row.size()) != cols) {
+                return Terrain{};
+            }
+            cells.insert(cells.end(), row.begin(), row.end());
+            rows++;
+        }
+    }
+
+    Terrain terrain(rows, cols);
+    for (int i = 0; i < static_cast<int>(cells.size()); i++) {
+        const int value = cells[i];
+        if (value == blocked) {
+            terrain.SetCost(i / cols, i % cols, Terrain::kBlocked);
+        } else if (value < 1 || value > Terrain::kMaxCost) {
+            return Terrain{};
+        } else {
+            terrain.SetCost(i / cols, i % cols, value);
+        }
+    }
+    return terrain;
+}
+
+// FindPath() on a Terrain, the cost in result is the weighted path cost
+template <typename Neighborhood = FourConnected>
+bool FindPath( const Terrain &terrain, Point init, Point goal, WideSearchContext &context,
+               vector<Point> &path, SearchResult *result = nullptr ) {
+    return FindPath<Neighborhood>(terrain.View(), init, goal, context, path, result,
+                                  TerrainCost(terrain));
+}
+
+template <typename Neighborhood = FourConnected>
+vector<Point> FindPath( const Terrain &terrain, Point init, Point goal, WideSearchContext &context,
+                        SearchResult *result = nullptr ) {
+    vector<Point> path;
+    FindPath<Neighborhood>(terrain, init, goal, context, path, result);
+    return path;
+}
+
+#endif
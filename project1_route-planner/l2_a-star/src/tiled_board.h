@@ -0,0 +1,446 @@
+#ifndef TILED_BOARD_H
+#define TILED_BOARD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "board.h"
+#include "grid_search.h"
+#include "neighborhood.h"
+
+/* TILED BOARD FORMAT (version 1):
+ * A board too big for memory is stored as square tiles of tile_size x
+ * tile_size cells, one State byte per cell, every tile in one contiguous
+ * block. Tiles are stored row-major (tile (i, j) is tile number
+ * i * tiles_y + j) after a 64-byte header:
+ *
+ *   offset  size  field
+ *   0       4     magic "TILE"
+ *   4       2     version (kTiledBoardVersion)
+ *   6       2     reserved
+ *   8       4     rows
+ *   12      4     cols
+ *   16      4     tile size (a power of two)
+ *   20      4     tiles_x - tiles down the board
+ *   24      4     tiles_y - tiles across the board
+ *   28      4     reserved
+ *   32      8     payload offset from the start of the file
+ *   40      8     payload size in bytes
+ *
+ * The edge tiles are padded with kObstacle. Integers are in host byte order.
+ */
+
+const char kTiledBoardMagic[4]{'T', 'I', 'L', 'E'};
+const std::uint16_t kTiledBoardVersion = 1;
+const std::uint32_t kTiledBoardPayloadOffset = 64;
+
+struct TiledBoardHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t reserved;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t tile_size;
+    std::uint32_t tiles_x;
+    std::uint32_t tiles_y;
+    std::uint32_t reserved2;
+    std::uint64_t payload_offset;
+    std::uint64_t payload_size;
+    char padding[16];
+};
+
+static_assert(sizeof(TiledBoardHeader) == 64, "TiledBoardHeader must be 64 bytes");
+
+bool WriteTiledBoard( const GridView &board, const std::string &path, int tile_size = 256 ) {
+    if (tile_size <= 0 || (tile_size & (tile_size - 1)) != 0) {
+        return false;
+    }
+    TiledBoardHeader header{};
+    std::memcpy(header.magic, kTiledBoardMagic, sizeof(header.magic));
+    header.version = kTiledBoardVersion;
+    header.rows = board.Rows();
+    header.cols = board.Cols();
+    header.tile_size = tile_size;
+    header.tiles_x = (header.rows + tile_size - 1) / tile_size;
+    header.tiles_y = (header.cols + tile_size - 1) / tile_size;
+    header.payload_offset = kTiledBoardPayloadOffset;
+    header.payload_size = std::uint64_t(header.tiles_x) * header.tiles_y * tile_size * tile_size;
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::vector<State> tile(std::size_t(tile_size) * tile_size);
+    for (std::uint32_t i = 0; i < header.tiles_x; i++) {
+        for (std::uint32_t j = 0; j < header.tiles_y; j++) {
+            std::fill(tile.begin(), tile.end(), State::kObstacle);
+            for (int dx = 0; dx < tile_size; dx++) {
+                const int x = i * tile_size + dx;
+                const int y = j * tile_size;
+                if (x < board.Rows()) {
+                    const int count = std::min(tile_size, board.Cols() - y);
+                    std::memcpy(tile.data() + dx * tile_size, board.Row(x) + y, count);
+                }
+            }
+            file.write(reinterpret_cast<const char *>(tile.data()), tile.size());
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+/* TILED BOARD:
+ * A board in the tiled format that is read from disk tile by tile as the
+ * search gets there. At most cache_tiles tiles are in memory at a time; when
+ * the cache is full, the least recently used tile makes room. Every cell read
+ * counts as a cache hit or a miss (a miss reads the tile with one pread()).
+ *
+ * It has the read-only accessors of GridView, but Index() is a 64-bit
+ * x * cols + y: the board may have more than 2^31 cells. Search it with
+ * TiledSearch (below), not with a SearchContext, which would take ~20 bytes
+ * of memory for every cell of the board. Reads go through a cache that the
+ * const accessors update, so a TiledBoard must not be shared between threads.
+ */
+class TiledBoard {
+  public:
+    TiledBoard() = default;
+    explicit TiledBoard( const std::string &path, int cache_tiles = 64 ) { Open(path, cache_tiles); }
+    ~TiledBoard() { Close(); }
+
+    TiledBoard( const TiledBoard & ) = delete;
+    TiledBoard &operator=( const TiledBoard & ) = delete;
+
+    // returns false if the file is missing, truncated or not a version 1 tiled board
+    bool Open( const std::string &path, int cache_tiles = 64 ) {
+        Close();
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            return false;
+        }
+        const bool valid =
+            ::pread(fd_, &header_, sizeof(header_), 0) == sizeof(header_) &&
+            std::memcmp(header_.magic, kTiledBoardMagic, sizeof(header_.magic)) == 0 &&
+            header_.version == kTiledBoardVersion && header_.tile_size > 0 &&
+            header_.rows <= std::uint32_t(std::numeric_limits<int>::max()) &&
+            header_.cols <= std::uint32_t(std::numeric_limits<int>::max()) &&
+            (header_.tile_size & (header_.tile_size - 1)) == 0 &&
+            header_.tiles_x == (header_.rows + header_.tile_size - 1) / header_.tile_size &&
+            header_.tiles_y == (header_.cols + header_.tile_size - 1) / header_.tile_size &&
+            std::uint64_t(header_.tiles_x) * header_.tiles_y <=
+                std::uint64_t(std::numeric_limits<int>::max()) &&
+            header_.payload_size == std::uint64_t(header_.tiles_x) * header_.tiles_y *
+                                        header_.tile_size * header_.tile_size &&
+            ::lseek(fd_, 0, SEEK_END) >= off_t(header_.payload_offset + header_.payload_size);
+        if (!valid || cache_tiles <= 0) {
+            Close();
+            return false;
+        }
+        rows_ = header_.rows;
+        cols_ = header_.cols;
+        shift_ = __builtin_ctz(header_.tile_size);
+        tile_cells_ = std::size_t(header_.tile_size) * header_.tile_size;
+        slot_of_tile_.assign(std::size_t(header_.tiles_x) * header_.tiles_y, -1);
+        tile_of_slot_.assign(cache_tiles, -1);
+        last_used_.assign(cache_tiles, 0);
+        cache_.assign(tile_cells_ * cache_tiles, State::kObstacle);
+        return true;
+    }
+
+    void Close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        rows_ = 0;
+        cols_ = 0;
+        cache_.clear();
+        slot_of_tile_.clear();
+        tile_of_slot_.clear();
+        last_used_.clear();
+        current_tile_ = -1;
+        current_ = nullptr;
+        hits_ = 0;
+        misses_ = 0;
+        clock_ = 0;
+    }
+
+    bool IsOpen() const { return fd_ >= 0; }
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    std::int64_t Size() const { return std::int64_t(rows_) * cols_; }
+    bool Empty() const { return rows_ == 0 || cols_ == 0; }
+    int TileSize() const { return header_.tile_size; }
+    int CacheTiles() const { return tile_of_slot_.size(); }
+
+    bool InBounds( int x, int y ) const {
+        return x >= 0 && x < rows_ && y >= 0 && y < cols_;
+    }
+
+    std::int64_t Index( int x, int y ) const { return std::int64_t(x) * cols_ + y; }
+    int IndexX( std::int64_t index ) const { return static_cast<int>(index / cols_); }
+    int IndexY( std::int64_t index ) const { return static_cast<int>(index % cols_); }
+
+    // pages the tile of (x, y) in if it isn't cached
+    State operator()( int x, int y ) const {
+        const int tile = (x >> shift_) * header_.tiles_y + (y >> shift_);
+        if (tile == current_tile_) {
+            hits_++;
+        } else {
+            current_ = Load(tile);
+            current_tile_ = tile;
+        }
+        const int mask = header_.tile_size - 1;
+        return current_[((x & mask) << shift_) + (y & mask)];
+    }
+
+    long long Hits() const { return hits_; }
+    long long Misses() const { return misses_; }
+    void ResetCounters() { hits_ = misses_ = 0; }
+
+  private:
+    // the cached cells of a tile, read from disk into the least recently
+    // used slot on a miss
+    const State *Load( int tile ) const {
+        int slot = slot_of_tile_[tile];
+        if (slot >= 0) {
+            hits_++;
+        } else {
+            misses_++;
+            slot = 0;
+            for (int s = 1; s < CacheTiles(); s++) {
+                if (last_used_[s] < last_used_[slot]) {
+                    slot = s;
+                }
+            }
+            if (tile_of_slot_[slot] >= 0) {
+                slot_of_tile_[tile_of_slot_[slot]] = -1;
+            }
+            tile_of_slot_[slot] = tile;
+            slot_of_tile_[tile] = slot;
+            const off_t offset = header_.payload_offset + off_t(tile) * tile_cells_;
+            if (::pread(fd_, cache_.data() + slot * tile_cells_, tile_cells_, offset) !=
+                static_cast<ssize_t>(tile_cells_)) {
+                // a file that shrank under us reads as blocked
+                std::fill_n(cache_.data() + slot * tile_cells_, tile_cells_, State::kObstacle);
+            }
+        }
+        last_used_[slot] = ++clock_;
+        return cache_.data() + slot * tile_cells_;
+    }
+
+    int fd_ = -1;
+    TiledBoardHeader header_{};
+    int rows_ = 0;
+    int cols_ = 0;
+    int shift_ = 0;                 // log2 of the tile size
+    std::size_t tile_cells_ = 0;
+
+    // the cache; everything below changes on reads
+    mutable std::vector<State> cache_;              // CacheTiles() tiles
+    mutable std::vector<int> slot_of_tile_;         // -1 if the tile isn't cached
+    mutable std::vector<int> tile_of_slot_;         // -1 if the slot is unused
+    mutable std::vector<std::uint64_t> last_used_;  // clock_ at the last use of each slot
+    mutable std::uint64_t clock_ = 0;
+    mutable int current_tile_ = -1;                 // tile of the last read
+    mutable const State *current_ = nullptr;
+    mutable long long hits_ = 0;
+    mutable long long misses_ = 0;
+};
+
+/* SEARCHING A TILED BOARD:
+ * A* whose per-query state grows with the part of the board the search
+ * reaches, not with the board: node state is paged per tile, like the cells.
+ * The first time the search reaches a tile it gets a block with one Node
+ * (g, the move that led there, closed flag) per cell of the tile; a hash map
+ * finds the block of a tile, and the block of the last tile is remembered, so
+ * most lookups are an array access. Blocks go back to a pool after every
+ * query.
+ *
+ * The open list is a binary heap with lazy deletion: a cell that gets a
+ * smaller g is pushed again, and the old entry is skipped when it comes off
+ * the heap (the open list of HDA* works the same way). Cell ids, g-values and
+ * the cost in the SearchResult are 64 bit.
+ *
+ * WHY NOT SearchBoardUntil():
+ * The A* loop of grid_search.h is written against a SearchContext, and every
+ * part of that is dense and int-indexed: Reset(size) sizes the node table for
+ * the whole board, the open list (an IndexedMinHeap) keeps a position per
+ * cell id for decrease-key, parents are int cell ids, and the generation
+ * stamps only clear cheaply because the table is flat. A board with more than
+ * 2^31 cells breaks the int ids, and a position table alone would be 8 bytes
+ * per cell of the board - the memory this search exists to avoid. A sparse
+ * context would have to replace all of it (64-bit ids, a heap without a
+ * position table, paged nodes), which leaves nothing of SearchContext to
+ * share, so the loop is written out once more here instead of making
+ * grid_search.h generic over two unrelated context types.
+ */
+template <typename Neighborhood = FourConnected>
+class TiledSearch {
+  public:
+    /**
+     * Optimal path from init to goal (both included) like FindPath(). Returns
+     * false with an empty path if there is none, or if init or goal is off
+     * the board or blocked.
+     */
+    bool FindPath( const TiledBoard &board, Point init, Point goal, std::vector<Point> &path,
+                   SearchResult *result = nullptr ) {
+        path.clear();
+        Start(board);
+        SearchResult summary;
+        if (board.Empty() || !board.InBounds(init.x, init.y) || !board.InBounds(goal.x, goal.y) ||
+            board(init.x, init.y) == State::kObstacle || board(goal.x, goal.y) == State::kObstacle) {
+            if (result) {
+                *result = summary;
+            }
+            return false;
+        }
+
+        const std::int64_t goal_id = board.Index(goal.x, goal.y);
+        At(init.x, init.y).g = 0;
+        Push(board.Index(init.x, init.y), 0,
+             Neighborhood::Heuristic(init.x, init.y, goal.x, goal.y));
+        while (!open_list_.empty()) {
+            std::pop_heap(open_list_.begin(), open_list_.end(), Later{});
+            const Entry entry = open_list_.back();
+            open_list_.pop_back();
+            const int x = board.IndexX(entry.id);
+            const int y = board.IndexY(entry.id);
+            Node &current = At(x, y);
+            if (current.closed || entry.g != current.g) {
+                continue; // stale
+            }
+            current.closed = true;
+            summary.expansions++;
+            if (entry.id == goal_id) {
+                summary.found = true;
+                summary.cost = entry.g;
+                break;
+            }
+
+            for (int i = 0; i < Neighborhood::kNeighbors; i++) {
+                const int next_x = x + Neighborhood::kDelta[i][0];
+                const int next_y = y + Neighborhood::kDelta[i][1];
+                if (!board.InBounds(next_x, next_y) || board(next_x, next_y) == State::kObstacle ||
+                    !Neighborhood::CanMove(board, x, y, i)) {
+                    continue;
+                }
+                const std::int64_t g = entry.g + Neighborhood::kCost[i];
+                Node &next = At(next_x, next_y);
+                if (!next.closed && g < next.g) {
+                    next.g = g;
+                    next.move = i;
+                    Push(board.Index(next_x, next_y), g,
+                         Neighborhood::Heuristic(next_x, next_y, goal.x, goal.y));
+                }
+            }
+        }
+
+        if (summary.found) {
+            Point cell = goal;
+            path.push_back(cell);
+            for (int move = At(goal.x, goal.y).move; move != kNoMove;) {
+                cell = Point{cell.x - Neighborhood::kDelta[move][0],
+                             cell.y - Neighborhood::kDelta[move][1]};
+                path.push_back(cell);
+                move = At(cell.x, cell.y).move;
+            }
+            std::reverse(path.begin(), path.end());
+        }
+        if (result) {
+            *result = summary;
+        }
+        return summary.found;
+    }
+
+    // tiles the last search reached
+    int Tiles() const { return used_; }
+
+    // bytes of per-query state the last search used: the blocks of the tiles
+    // it reached, and the heap
+    std::size_t MemoryBytes() const {
+        // a hash map node: the pair, the next pointer and a bucket
+        const std::size_t map_entry = sizeof(std::pair<std::int64_t, int>) + 2 * sizeof(void *);
+        return std::size_t(used_) * tile_cells_ * sizeof(Node) +
+               block_of_tile_.size() * map_entry + open_list_.capacity() * sizeof(Entry);
+    }
+
+  private:
+    static constexpr std::int64_t kInfinity = std::numeric_limits<std::int64_t>::max();
+    static constexpr std::int8_t kNoMove = -1;
+
+    struct Node {
+        std::int64_t g = kInfinity;
+        std::int8_t move = kNoMove;     // the Neighborhood move that reached the cell
+        bool closed = false;
+    };
+
+    // open list entry, stale once the cell got a smaller g or was expanded
+    struct Entry {
+        std::int64_t f;
+        std::int64_t g;
+        std::int64_t id;
+        int h;
+    };
+
+    // std::push_heap() keeps the max on top, so "less" means "comes later"
+    struct Later {
+        bool operator()( const Entry &a, const Entry &b ) const {
+            return a.f > b.f || (a.f == b.f && a.h > b.h);
+        }
+    };
+
+    // forgets the last query, keeping the blocks for this one
+    void Start( const TiledBoard &board ) {
+        shift_ = __builtin_ctz(std::max(board.TileSize(), 1));
+        tiles_y_ = (std::int64_t(board.Cols()) + board.TileSize() - 1) >> shift_;
+        tile_cells_ = std::size_t(1) << (2 * shift_);
+        block_of_tile_.clear();
+        used_ = 0;
+        last_tile_ = -1;
+        open_list_.clear();
+    }
+
+    Node &At( int x, int y ) {
+        const std::int64_t tile = (std::int64_t(x) >> shift_) * tiles_y_ + (y >> shift_);
+        if (tile != last_tile_) {
+            auto [it, added] = block_of_tile_.try_emplace(tile, used_);
+            if (added) {
+                if (used_ == static_cast<int>(blocks_.size())) {
+                    blocks_.emplace_back();
+                }
+                blocks_[used_].assign(tile_cells_, Node{});
+                used_++;
+            }
+            last_tile_ = tile;
+            last_block_ = blocks_[it->second].data();
+        }
+        const int mask = (1 << shift_) - 1;
+        return last_block_[(std::size_t(x & mask) << shift_) + (y & mask)];
+    }
+
+    void Push( std::int64_t id, std::int64_t g, int h ) {
+        open_list_.push_back(Entry{g + h, g, id, h});
+        std::push_heap(open_list_.begin(), open_list_.end(), Later{});
+    }
+
+    int shift_ = 0;                                     // log2 of the tile size
+    std::int64_t tiles_y_ = 0;
+    std::size_t tile_cells_ = 0;
+    std::vector<std::vector<Node>> blocks_;             // the first used_ belong to this query
+    int used_ = 0;
+    std::unordered_map<std::int64_t, int> block_of_tile_;
+    std::int64_t last_tile_ = -1;
+    Node *last_block_ = nullptr;
+    std::vector<Entry> open_list_;
+};
+
+#endif
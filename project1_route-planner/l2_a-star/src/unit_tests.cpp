@@ -16,6 +16,16 @@ void PrintVectorOfVectors(vector<vector<int>> v) {
   }
 }
 
+void PrintNode(const SearchNode &node) {
+  cout << "{ " << node.x << " " << node.y << " " << node.g << " " << node.h << " }" << "\n";
+}
+
+void PrintNodes(const vector<SearchNode> &nodes) {
+  for (const SearchNode &node : nodes) {
+    PrintNode(node);
+  }
+}
+
 void PrintVectorOfVectors(vector<vector<State>> v) {
   for (auto row : v) {
     cout << "{ ";
@@ -52,9 +62,9 @@ void TestAddToOpen() {
   int y = 0;
   int g = 5;
   int h = 7;
-  vector<vector<int>> open{{0, 0, 2, 9}, {1, 0, 2, 2}, {2, 0, 2, 4}};
-  vector<vector<int>> solution_open = open; 
-  solution_open.push_back(vector<int>{3, 0, 5, 7});
+  vector<SearchNode> open{{0, 0, 2, 9}, {1, 0, 2, 2}, {2, 0, 2, 4}};
+  vector<SearchNode> solution_open = open; 
+  solution_open.push_back(SearchNode{3, 0, 5, 7});
   vector<vector<State>> grid{{State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
                             {State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
                             {State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
@@ -67,9 +77,9 @@ void TestAddToOpen() {
     cout << "failed" << "\n";
     cout << "\n";
     cout << "Your open list is: " << "\n";
-    PrintVectorOfVectors(open);
+    PrintNodes(open);
     cout << "Solution open list is: " << "\n";
-    PrintVectorOfVectors(solution_open);
+    PrintNodes(solution_open);
     cout << "\n";
   } else if (grid != solution_grid) {
     cout << "failed" << "\n";
@@ -89,25 +99,25 @@ void TestAddToOpen() {
 void TestCompare() {
   cout << "----------------------------------------------------------" << "\n";
   cout << "Compare Function Test: ";
-  vector<int> test_1 {1, 2, 5, 6};
-  vector<int> test_2 {1, 3, 5, 7};
-  vector<int> test_3 {1, 2, 5, 8};
-  vector<int> test_4 {1, 3, 5, 7};
+  SearchNode test_1 {1, 2, 5, 6};
+  SearchNode test_2 {1, 3, 5, 7};
+  SearchNode test_3 {1, 2, 5, 8};
+  SearchNode test_4 {1, 3, 5, 7};
   if (Compare(test_1, test_2)) {
     cout << "failed" << "\n";
     cout << "\n" << "a = ";
-    PrintVector(test_1);
+    PrintNode(test_1);
     cout << "b = ";
-    PrintVector(test_2);
+    PrintNode(test_2);
     cout << "Compare(a, b): " << Compare(test_1, test_2) << "\n";
     cout << "Correct answer: 0" << "\n";
     cout << "\n";
   } else if (!Compare(test_3, test_4)) {
     cout << "failed" << "\n";
     cout << "\n" << "a = ";
-    PrintVector(test_3);
+    PrintNode(test_3);
     cout << "b = ";
-    PrintVector(test_4);
+    PrintNode(test_4);
     cout << "Compare(a, b): " << Compare(test_3, test_4) << "\n";
     cout << "Correct answer: 1" << "\n";
     cout << "\n";
@@ -177,12 +187,12 @@ void TestCheckValidCell() {
 void TestExpandNeighbors() {
   cout << "----------------------------------------------------------" << "\n";
   cout << "ExpandNeighbors Function Test: ";
-  vector<int> current{4, 2, 7, 3};
+  SearchNode current{4, 2, 7, 3};
   int goal[2] {4, 5};
-  vector<vector<int>> open{{4, 2, 7, 3}};
-  vector<vector<int>> solution_open = open;
-  solution_open.push_back(vector<int>{3, 2, 8, 4});
-  solution_open.push_back(vector<int>{4, 3, 8, 2});
+  vector<SearchNode> open{{4, 2, 7, 3}};
+  vector<SearchNode> solution_open = open;
+  solution_open.push_back(SearchNode{3, 2, 8, 4});
+  solution_open.push_back(SearchNode{4, 3, 8, 2});
   vector<vector<State>> grid{{State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
                             {State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
                             {State::kClosed, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
@@ -198,9 +208,9 @@ void TestExpandNeighbors() {
     cout << "failed" << "\n";
     cout << "\n";
     cout << "Your open list is: " << "\n";
-    PrintVectorOfVectors(open);
+    PrintNodes(open);
     cout << "Solution open list is: " << "\n";
-    PrintVectorOfVectors(solution_open);
+    PrintNodes(solution_open);
     cout << "\n";
   } else if (grid != solution_grid) {
     cout << "failed" << "\n";
@@ -216,4 +226,968 @@ void TestExpandNeighbors() {
   }
   cout << "----------------------------------------------------------" << "\n";
   return;
-}
\ No newline at end of file
+}
+
+void TestOpenList() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "OpenList Test: ";
+  OpenList open(6);
+  open.Push(0, OpenKey{9, 9});
+  open.Push(1, OpenKey{4, 2});
+  open.Push(2, OpenKey{7, 3});
+  open.Push(3, OpenKey{4, 1});
+  open.Push(4, OpenKey{8, 0});
+  open.PushOrDecrease(0, OpenKey{5, 5});  // decrease-key
+  open.PushOrDecrease(2, OpenKey{8, 3});  // worse key, ignored
+  vector<int> solution_order{3, 1, 0, 2, 4};
+  vector<int> order;
+  while (!open.Empty()) {
+    order.push_back(open.Pop().id);
+  }
+  if (order != solution_order || open.Contains(0)) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Your pop order: ";
+    PrintVector(order);
+    cout << "Solution pop order: ";
+    PrintVector(solution_order);
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestGrid() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "Grid Test: ";
+  int init[2]{0, 0};
+  int goal[2]{4, 5};
+  vector<vector<State>> board{{State::kEmpty, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
+                              {State::kEmpty, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
+                              {State::kEmpty, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
+                              {State::kEmpty, State::kObstacle, State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty},
+                              {State::kEmpty, State::kEmpty, State::kEmpty, State::kEmpty, State::kObstacle, State::kEmpty}};
+  Grid grid(board);
+  auto solution = Search(board, init, goal);
+  auto output = Search(grid, init, goal);
+  if (sizeof(State) != 1 || grid.Index(4, 5) != 29 || grid(3, 1) != State::kObstacle) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Grid layout is not flat row-major with 1-byte cells" << "\n";
+    cout << "\n";
+  } else if (output.ToNested() != solution) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Search(board, {0,0}, {4,5}) on the Grid: " << "\n";
+    PrintVectorOfVectors(output.ToNested());
+    cout << "Search(board, {0,0}, {4,5}) on the nested board: " << "\n";
+    PrintVectorOfVectors(solution);
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestLoadBoardMmap() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "LoadBoardMmap Test: ";
+  std::string path = "../data/1.board";
+  Grid solution = ReadGridFile(path);
+  Grid output = LoadBoardMmap(path);
+  // a number too long for an int
+  std::string long_path = "/tmp/test_load_board_mmap.board";
+  std::ofstream(long_path) << "0," << std::string(40, '9') << "," << "\n";
+  bool rejected = LoadBoardMmap(long_path).Empty();
+  std::remove(long_path.c_str());
+  if (!rejected) {
+    cout << "failed" << "\n";
+    cout << "\n" << "LoadBoardMmap() accepted a 40 digit number" << "\n";
+    cout << "\n";
+  } else if (output.Empty() || output != solution) {
+    cout << "failed" << "\n";
+    cout << "\n" << "LoadBoardMmap(\"" << path << "\") = " << "\n";
+    PrintVectorOfVectors(output.ToNested());
+    cout << "Solution board: " << "\n";
+    PrintVectorOfVectors(solution.ToNested());
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestBinaryBoard() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "BinaryBoard Test: ";
+  std::string path = "../data/1.board";
+  std::string binary_path = "/tmp/test_binary_board.bin";
+  Grid solution = ReadGridFile(path);
+  bool passed = true;
+  for (BoardEncoding encoding : {BoardEncoding::kState8, BoardEncoding::kBit1}) {
+    ConvertBoardFile(path, binary_path, encoding);
+    MappedBoard board(binary_path);
+    Grid output = board.ToGrid();
+    bool in_place = encoding != BoardEncoding::kState8 ||
+                    (!board.View().Empty() && board.View()(3, 1) == State::kObstacle);
+    if (!board.IsOpen() || output != solution || !in_place) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Binary board (encoding " << static_cast<int>(encoding) << "): " << "\n";
+      PrintVectorOfVectors(output.ToNested());
+      cout << "Solution board: " << "\n";
+      PrintVectorOfVectors(solution.ToNested());
+      cout << "\n";
+      passed = false;
+      break;
+    }
+  }
+  // a payload offset inside the header, a cell byte that isn't a State, and
+  // a bit past the 6 columns of the first kBit1 row (bit 8 of its word)
+  struct Corruption {
+    BoardEncoding encoding;
+    int offset;
+    char byte;
+  };
+  for (Corruption corrupt : {Corruption{BoardEncoding::kState8, 20, 16},
+                             Corruption{BoardEncoding::kState8, 64 + 7, 42},
+                             Corruption{BoardEncoding::kBit1, 64 + 1, 1}}) {
+    ConvertBoardFile(path, binary_path, corrupt.encoding);
+    std::fstream file(binary_path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(corrupt.offset);
+    file.put(corrupt.byte);
+    file.close();
+    if (passed && MappedBoard(binary_path).IsOpen()) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Opened a board with byte " << corrupt.offset << " corrupted" << "\n";
+      cout << "\n";
+      passed = false;
+    }
+  }
+  std::remove(binary_path.c_str());
+  if (passed) {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestPassabilityBitmap() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "PassabilityBitmap Test: ";
+  int init[2]{0, 0};
+  int goal[2]{4, 5};
+  Grid grid = ReadGridFile("../data/1.board");
+  PassabilityBitmap free_cells(grid);
+  // every neighbor mask must agree with a plain bounds + State check
+  bool masks_match = true;
+  for (int x = 0; x < grid.Rows(); x++) {
+    for (int y = 0; y < grid.Cols(); y++) {
+      unsigned mask = free_cells.NeighborMask8(x, y);
+      for (int i = 0; i < 8; i++) {
+        int nx = x + kBitmapDelta8[i][0];
+        int ny = y + kBitmapDelta8[i][1];
+        bool free = grid.InBounds(nx, ny) && grid(nx, ny) != State::kObstacle;
+        masks_match = masks_match && free == static_cast<bool>((mask >> i) & 1);
+      }
+    }
+  }
+  if (!masks_match) {
+    cout << "failed" << "\n";
+    cout << "\n" << "NeighborMask8() disagrees with the board" << "\n";
+    cout << "\n";
+  } else if (free_cells.NextBlocked(0, 0) != 1 || free_cells.NextFree(4, 4) != 5 ||
+             free_cells.NextBlocked(0, 2) != 6 || free_cells.CountFree(4) != 5) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Row scans of row 0 / row 4 are wrong" << "\n";
+    cout << "\n";
+  } else if (Search(grid, free_cells, init, goal) != Search(grid, init, goal)) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Search(grid, free_cells, {0,0}, {4,5}) = " << "\n";
+    PrintVectorOfVectors(Search(grid, free_cells, init, goal).ToNested());
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestJumpPointSearch() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "JumpPointSearch Test: ";
+  // a corridor that forces a detour around the column of obstacles
+  vector<vector<int>> queries{{0, 0, 4, 5}, {0, 0, 0, 5}, {3, 5, 0, 0}, {4, 0, 0, 2}};
+  Grid grid = ReadGridFile("../data/1.board");
+  // the same queries again on one context and bitmap
+  SearchContext context;
+  PassabilityBitmap free_cells(grid);
+  for (auto query : queries) {
+    int init[2]{query[0], query[1]};
+    int goal[2]{query[2], query[3]};
+    SearchResult solution;
+    SearchResult output;
+    SearchResult reused;
+    Search(grid, init, goal, SearchMode::kAStar, &solution);
+    Search(grid, init, goal, SearchMode::kJumpPoint, &output);
+    bool found = JumpPointSearch(grid.View(), free_cells, Point{init[0], init[1]},
+                                 Point{goal[0], goal[1]}, context, &reused);
+    if (!output.found || output.cost != solution.cost || !found || reused.cost != solution.cost) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Query: ";
+      PrintVector(query);
+      cout << "JPS path length: " << output.cost << ", reused context: " << reused.cost << "\n";
+      cout << "A* path length: " << solution.cost << "\n";
+      cout << "\n";
+      return;
+    }
+  }
+  // a blocked start, a blocked goal, and a start off the board
+  vector<vector<int>> unreachable{{3, 1, 0, 0}, {0, 0, 3, 1}, {-1, 0, 0, 0}, {0, 0, 5, 0}};
+  for (auto query : unreachable) {
+    int init[2]{query[0], query[1]};
+    int goal[2]{query[2], query[3]};
+    SearchResult output{true, 1, 1};
+    std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+    Grid path = Search(grid, init, goal, SearchMode::kJumpPoint, &output);
+    std::cout.clear();
+    if (output.found || !path.Empty()) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Query: ";
+      PrintVector(query);
+      cout << "JPS found a path, there is none" << "\n";
+      cout << "\n";
+      return;
+    }
+  }
+  cout << "passed" << "\n";
+  return;
+}
+
+void TestBidirectionalSearch() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "BidirectionalSearch Test: ";
+  vector<vector<int>> queries{{0, 0, 4, 5}, {0, 0, 0, 5}, {3, 5, 0, 0}, {4, 0, 0, 2}, {2, 2, 2, 2}};
+  Grid grid = ReadGridFile("../data/1.board");
+  // the same queries again on one context
+  BidirectionalContext context;
+  for (auto query : queries) {
+    int init[2]{query[0], query[1]};
+    int goal[2]{query[2], query[3]};
+    SearchResult solution;
+    SearchResult output;
+    SearchResult reused;
+    Search(grid, init, goal, SearchMode::kAStar, &solution);
+    Search(grid, init, goal, SearchMode::kBidirectional, &output);
+    bool found = BidirectionalSearch(grid.View(), Point{init[0], init[1]}, Point{goal[0], goal[1]},
+                                     context, &reused);
+    if (!output.found || output.cost != solution.cost || !found || reused.cost != solution.cost) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Query: ";
+      PrintVector(query);
+      cout << "Bidirectional path length: " << output.cost << ", reused context: " << reused.cost
+           << "\n";
+      cout << "A* path length: " << solution.cost << "\n";
+      cout << "\n";
+      return;
+    }
+  }
+  // a goal on an obstacle, the same blocked cell as start and goal, and a
+  // goal off the board
+  vector<vector<int>> unreachable{{0, 0, 3, 1}, {3, 1, 3, 1}, {0, 0, 0, 6}};
+  for (auto query : unreachable) {
+    int init[2]{query[0], query[1]};
+    int goal[2]{query[2], query[3]};
+    SearchResult output{true, 1, 1};
+    std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+    Grid path = Search(grid, init, goal, SearchMode::kBidirectional, &output);
+    std::cout.clear();
+    if (output.found || !path.Empty()) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Query: ";
+      PrintVector(query);
+      cout << "Bidirectional search found a path, there is none" << "\n";
+      cout << "\n";
+      return;
+    }
+  }
+  cout << "passed" << "\n";
+  return;
+}
+
+void TestHierarchicalMap() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "HierarchicalMap Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  HierarchicalMap map;
+  map.Build(grid.View(), 2);
+  std::string path = "/tmp/test_hierarchical_map.hpa";
+  HierarchicalMap warm;
+  bool loaded = map.Save(path) && warm.Load(path) && warm.Matches(grid.View()) &&
+                warm.NodeCount() == map.NodeCount() && warm.EdgeCount() == map.EdgeCount();
+  // a node cell off the board (the first cell follows the 32-byte header), then
+  // a truncated file: both are rejected and warm keeps the map it had
+  bool kept = true;
+  for (int corrupt : {0, 1}) {
+    map.Save(path);
+    if (corrupt == 0) {
+      std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(32);
+      file.put(char(100));
+    } else {
+      std::ifstream file(path, std::ios::binary);
+      std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      file.close();
+      std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size() - 4);
+    }
+    kept = kept && !warm.Load(path) && warm.Matches(grid.View()) &&
+           warm.NodeCount() == map.NodeCount() && warm.EdgeCount() == map.EdgeCount();
+  }
+  std::remove(path.c_str());
+  Grid smaller(4, 6);
+  bool mismatch = warm.FindPath(smaller.View(), Point{0, 0}, Point{3, 5}).empty();
+
+  SearchResult result;
+  vector<Point> output = warm.FindPath(grid.View(), Point{0, 0}, Point{4, 5}, &result);
+  // HPA* paths are near optimal: a valid path, at least as long as the optimal 11
+  bool valid = result.found && result.cost >= 11 && output.size() == std::size_t(result.cost) + 1 &&
+               output.front() == (Point{0, 0}) && output.back() == (Point{4, 5});
+  for (std::size_t i = 1; valid && i < output.size(); i++) {
+    int step = std::abs(output[i].x - output[i - 1].x) + std::abs(output[i].y - output[i - 1].y);
+    valid = step == 1 && grid(output[i].x, output[i].y) != State::kObstacle;
+  }
+  if (!loaded) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Save() / Load() round trip lost the abstract graph" << "\n";
+    cout << "\n";
+  } else if (!kept || !mismatch) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Accepted a corrupt file or a board of another size" << "\n";
+    cout << "\n";
+  } else if (!valid) {
+    cout << "failed" << "\n";
+    cout << "\n" << "FindPath({0,0}, {4,5}) = ";
+    for (Point p : output) {
+      cout << "(" << p.x << "," << p.y << ") ";
+    }
+    cout << "\n" << "Path length: " << result.cost << ", optimal: 11" << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestBatchPlanner() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "BatchPlanner Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  vector<Query> queries;
+  for (int i = 0; i < 200; i++) {
+    Query query{Point{i % grid.Rows(), (i / 7) % grid.Cols()},
+                Point{(i / 3) % grid.Rows(), (i * 5) % grid.Cols()}};
+    if (grid(query.init.x, query.init.y) != State::kObstacle &&
+        grid(query.goal.x, query.goal.y) != State::kObstacle) {
+      queries.push_back(query);
+    }
+  }
+  BatchPlanner planner(3);
+  vector<SearchResult> results;
+  vector<vector<Point>> paths = planner.Solve(grid.View(), queries, &results);
+  for (std::size_t i = 0; i < queries.size(); i++) {
+    int init[2]{queries[i].init.x, queries[i].init.y};
+    int goal[2]{queries[i].goal.x, queries[i].goal.y};
+    SearchResult solution;
+    std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+    Search(grid, init, goal, &solution);
+    std::cout.clear();
+    bool valid = results[i].found == solution.found && results[i].cost == solution.cost &&
+                 paths[i].size() == (solution.found ? std::size_t(solution.cost) + 1 : 0);
+    if (valid && solution.found) {
+      valid = paths[i].front() == queries[i].init && paths[i].back() == queries[i].goal;
+    }
+    for (std::size_t j = 1; valid && j < paths[i].size(); j++) {
+      int step = std::abs(paths[i][j].x - paths[i][j - 1].x) +
+                 std::abs(paths[i][j].y - paths[i][j - 1].y);
+      valid = step == 1 && grid(paths[i][j].x, paths[i][j].y) != State::kObstacle;
+    }
+    if (!valid) {
+      cout << "failed" << "\n";
+      cout << "\n" << "Query: (" << queries[i].init.x << "," << queries[i].init.y << ") -> ("
+           << queries[i].goal.x << "," << queries[i].goal.y << ")" << "\n";
+      cout << "BatchPlanner path length: " << results[i].cost << ", found: " << results[i].found << "\n";
+      cout << "A* path length: " << solution.cost << ", found: " << solution.found << "\n";
+      cout << "\n";
+      return;
+    }
+  }
+  cout << "passed" << "\n";
+  return;
+}
+
+void TestSearchContext() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "SearchContext Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchContext context;
+  vector<Point> path;
+  // a long query first, so the shorter ones after it fit into the same buffer
+  FindPath(grid.View(), Point{0, 0}, Point{4, 5}, context, path);
+  const Point *buffer = path.data();
+  for (int x = 0; x < grid.Rows(); x++) {
+    for (int y = 0; y < grid.Cols(); y++) {
+      int init[2]{x, y};
+      int goal[2]{4, 5};
+      SearchResult solution;
+      SearchResult output;
+      std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+      Grid fresh = Search(grid, init, goal, &solution);
+      Grid reused = Search(grid, init, goal, context, &output);
+      std::cout.clear();
+      bool found = FindPath(grid.View(), Point{x, y}, Point{4, 5}, context, path);
+      // a new generation must not see anything of the previous search
+      bool forgotten = true;
+      context.Reset(grid.Size());
+      for (int id = 0; id < grid.Size(); id++) {
+        forgotten = forgotten && !context.Seen(id) && !context.Closed(id) &&
+                    context.G(id) == SearchContext::kInfinity && context.Parent(id) == -1;
+      }
+      if (fresh != reused || output.cost != solution.cost || found != solution.found ||
+          (found && path.size() != std::size_t(solution.cost) + 1) || !forgotten ||
+          (found && path.data() != buffer)) {
+        cout << "failed" << "\n";
+        cout << "\n" << "Query: (" << x << "," << y << ") -> (4,5)" << "\n";
+        cout << "Reused context path length: " << output.cost << ", FindPath: " << path.size()
+             << ", fresh: " << solution.cost << "\n";
+        cout << "Reset() forgot the previous search: " << forgotten << "\n";
+        cout << "Path buffer reused: " << (path.data() == buffer) << "\n";
+        cout << "\n";
+        return;
+      }
+    }
+  }
+  cout << "passed" << "\n";
+  return;
+}
+
+void TestPathFormat() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "PathFormat Test: ";
+  vector<Point> path{{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}};
+  vector<Point> waypoints{{0, 0}, {2, 0}, {2, 2}, {1, 2}};
+  bool encoded = Waypoints(path) == waypoints && ExpandWaypoints(waypoints) == path &&
+                 EncodeMoves(path) == "D2R2U1" && DecodeMoves(Point{0, 0}, "D2R2U1") == path &&
+                 DecodeMoves(Point{0, 0}, "D2X1").empty() &&
+                 DecodeMoves(Point{0, 0}, "D99999999999999999999999").empty() &&
+                 DecodeMoves(Point{0, 0}, "D2R2U1", 4).empty() &&
+                 DecodeMoves(Point{0, 0}, "D2R2U1", 5) == path;
+
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchContext context;
+  vector<Point> route = FindPath(grid.View(), Point{0, 0}, Point{4, 5}, context);
+  std::string moves = EncodeMoves(route);
+  Grid drawn = DrawPath(grid.View(), route);
+  int path_cells = 0;
+  for (int id = 0; id < drawn.Size(); id++) {
+    path_cells += drawn.Data()[id] == State::kPath;
+  }
+  bool round_trip = route.size() == 12 && DecodeMoves(route.front(), moves) == route &&
+                    ExpandWaypoints(Waypoints(route)) == route &&
+                    path_cells == static_cast<int>(route.size()) - 2 &&
+                    drawn(0, 0) == State::kStart && drawn(4, 5) == State::kFinish;
+  if (!encoded || !round_trip) {
+    cout << "failed" << "\n";
+    cout << "\n" << "EncodeMoves({0,0} ... {1,2}) = " << EncodeMoves(path) << ", expected D2R2U1" << "\n";
+    cout << "Route ({0,0}, {4,5}) = " << moves << ", " << route.size() << " cells, expected 12" << "\n";
+    cout << "Solution board: " << "\n";
+    PrintBoard(drawn);
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestNeighborhood() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "Neighborhood Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchContext context;
+  SearchResult four;
+  SearchResult eight;
+  SearchResult no_cutting;
+  FindPath<FourConnected>(grid.View(), Point{0, 0}, Point{4, 5}, context, &four);
+  vector<Point> diagonal = FindPath<EightConnected>(grid.View(), Point{0, 0}, Point{4, 5}, context, &eight);
+  vector<Point> around = FindPath<EightConnectedNoCornerCutting>(grid.View(), Point{0, 0}, Point{4, 5},
+                                                                 context, &no_cutting);
+  // (3,0) -> (4,1) squeezes past the obstacle at (3,1), which only EightConnected allows
+  bool cuts_corner = false;
+  for (std::size_t i = 1; i < diagonal.size(); i++) {
+    cuts_corner = cuts_corner || (diagonal[i - 1] == (Point{3, 0}) && diagonal[i] == (Point{4, 1}));
+  }
+  bool heuristics = EightConnected::Heuristic(0, 0, 4, 5) == 4 * 14 + 10 &&
+                    FourConnected::Heuristic(0, 0, 4, 5) == Heuristic(0, 0, 4, 5);
+  if (four.cost != 11 || eight.cost != 92 || no_cutting.cost != 104 || !cuts_corner ||
+      !heuristics) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Path costs ({0,0}, {4,5}): 4-connected " << four.cost << " (expected 11), "
+         << "8-connected " << eight.cost << " (expected 92), "
+         << "no corner cutting " << no_cutting.cost << " (expected 104)" << "\n";
+    cout << "8-connected route: " << EncodeMoves(diagonal) << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestTerrain() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "Terrain Test: ";
+  Terrain terrain = ReadTerrainFile("../data/terrain.board");
+  WideSearchContext context;
+  SearchContext plain_context;
+  SearchResult weighted;
+  SearchResult plain;
+  // the short way runs along the expensive top row, the cheap one goes around
+  vector<Point> route = FindPath(terrain, Point{0, 0}, Point{4, 5}, context, &weighted);
+  FindPath(terrain.View(), Point{0, 0}, Point{4, 5}, plain_context, &plain);
+  int route_cost = 0;
+  for (std::size_t i = 1; i < route.size(); i++) {
+    route_cost += terrain.Cost(route[i].x, route[i].y);
+  }
+
+  // a Terrain of a plain board costs the same as the board itself
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchResult uniform;
+  FindPath(Terrain(grid.View()), Point{0, 0}, Point{4, 5}, context, &uniform);
+
+  // a different blocked sentinel, and a cost out of range
+  std::string path = "/tmp/test_terrain.board";
+  std::ofstream("/tmp/test_terrain.board") << "3,300,7," << "\n" << "1,1,3," << "\n";
+  Terrain sentinel = ReadTerrainFile(path, 300);
+  Terrain out_of_range = ReadTerrainFile(path);
+  std::remove(path.c_str());
+  bool loaded = sentinel.Rows() == 2 && sentinel.Cols() == 3 && sentinel.Cost(0, 0) == 3 &&
+                sentinel.Cost(0, 1) == Terrain::kBlocked &&
+                sentinel.View()(0, 1) == State::kObstacle && sentinel.MinCost() == 1 &&
+                sentinel.MaxCost() == 7 && out_of_range.Empty();
+
+  // int costs last up to 774 x 774 cells of cost 255, the 64-bit search goes on
+  Terrain expensive(800, 800, 255);
+  SearchResult wide;
+  bool boundary = Terrain(774, 774, 255).Fits() && !Terrain(775, 775, 255).Fits() &&
+                  !expensive.Fits() && Terrain(800, 800, 1).Fits() &&
+                  FindPath(expensive, Point{0, 0}, Point{799, 799}, context, &wide).size() == 1599 &&
+                  wide.found && wide.cost == 1598 * 255;
+
+  if (!weighted.found || weighted.cost != 15 || route.size() != 16 || route_cost != 15 ||
+      plain.cost != 9 || uniform.cost != 11 || terrain.MinCost() != 1 || !loaded || !boundary) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Weighted path cost ({0,0}, {4,5}): " << weighted.cost << " over "
+         << route.size() << " cells (expected 15 over 16)" << "\n";
+    cout << "Unweighted path length: " << plain.cost << " (expected 9)" << "\n";
+    cout << "Plain board as Terrain: " << uniform.cost << " (expected 11)" << "\n";
+    cout << "Sentinel / range checks: " << loaded << ", 64-bit costs: " << boundary << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestDStarLite() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "DStarLite Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  DStarLite<> planner;
+  planner.Plan(grid.View(), Point{0, 0}, Point{4, 5});
+  // block (3,4), open a gap at the top of the wall, cut the goal off
+  // completely, then reopen (3,4)
+  vector<vector<CellChange>> batches{
+    {{Point{3, 4}, State::kObstacle}},
+    {{Point{0, 1}, State::kEmpty}, {Point{1, 1}, State::kEmpty}},
+    {{Point{4, 1}, State::kObstacle}, {Point{2, 5}, State::kObstacle}},
+    {{Point{3, 4}, State::kEmpty}},
+  };
+  vector<int> costs{planner.Cost()};
+  SearchContext context;
+  bool matches = planner.Cost() == 11;
+  for (const auto &batch : batches) {
+    planner.UpdateCells(batch);
+    SearchResult solution;
+    FindPath(planner.Board().View(), Point{0, 0}, Point{4, 5}, context, &solution);
+    costs.push_back(planner.Found() ? planner.Cost() : -1);
+    matches = matches && planner.Found() == solution.found &&
+              (!solution.found || planner.Cost() == solution.cost);
+  }
+  // then drive one step along the path and replan from there
+  vector<Point> path = planner.Path();
+  if (path.size() > 1) {
+    planner.MoveStart(path[1]);
+    matches = matches && planner.Cost() == static_cast<int>(path.size()) - 2;
+  }
+  // moving off the board or into a wall is refused
+  matches = matches && !planner.MoveStart(Point{-1, 0}) && !planner.MoveStart(Point{2, 1}) &&
+            planner.Found();
+  // and so is planning from off the board, or from a blocked start to itself
+  DStarLite<> rejected;
+  bool refused = !rejected.Plan(grid.View(), Point{5, 0}, Point{4, 5}) && !rejected.Found() &&
+                 !rejected.Plan(grid.View(), Point{2, 1}, Point{2, 1}) && !rejected.Found() &&
+                 !rejected.Plan(grid.View(), Point{0, 0}, Point{3, 1}) && rejected.Path().empty();
+  if (!matches || !refused || path.empty() || path.front() != (Point{0, 0}) || path.back() != (Point{4, 5})) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Path costs after each batch: ";
+    PrintVector(costs);
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestAnytimeSearch() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "AnytimeSearch Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  vector<AnytimeSolution> solutions =
+      AnytimeSearch(grid.View(), Point{0, 0}, Point{4, 5}, 1000.0, 3.0, 1.0);
+  bool valid = !solutions.empty() && solutions.front().weight == 3.0 &&
+               solutions.back().cost == 11 && solutions.back().bound == 1.0;
+  int previous = std::numeric_limits<int>::max();
+  for (const AnytimeSolution &solution : solutions) {
+    valid = valid && solution.cost <= previous && solution.bound <= solution.weight &&
+            solution.cost <= solution.bound * 11 && solution.path.size() == solution.cost + 1u &&
+            solution.path.front() == (Point{0, 0}) && solution.path.back() == (Point{4, 5});
+    previous = solution.cost;
+  }
+  bool unreachable = AnytimeSearch(grid.View(), Point{0, 0}, Point{0, 1}, 1000.0).empty();
+  if (!valid || !unreachable) {
+    cout << "failed" << "\n";
+    for (const AnytimeSolution &solution : solutions) {
+      cout << "\n" << "w = " << solution.weight << ": cost " << solution.cost << ", bound "
+           << solution.bound;
+    }
+    cout << "\n" << "Optimal cost: 11, unreachable goal handled: " << unreachable << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestLandmarks() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "Landmarks Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  Landmarks<> landmarks;
+  landmarks.Build(grid.View(), 4);
+  std::string path = "/tmp/test_landmarks.alt";
+  Landmarks<> mapped;
+  bool loaded = landmarks.Save(path) && mapped.Open(path) && mapped.Matches(grid.View()) &&
+                mapped.Count() == 4 && mapped.Points() == landmarks.Points();
+  std::remove(path.c_str());
+  // the mapping outlives the file name, the estimate never overshoots the
+  // true distance, and beats Manhattan's 2 across the wall
+  Landmarks<>::Estimate estimate = mapped.For(Point{0, 0});
+  bool admissible = loaded && estimate(0, 0) == 0 && estimate(0, 2) > 2 &&
+                    estimate(0, 2) <= 10 && estimate(4, 5) <= 11;
+
+  SearchContext context;
+  SearchResult result;
+  vector<Point> output;
+  bool found = mapped.FindPath(grid.View(), Point{0, 0}, Point{4, 5}, context, output, &result);
+  bool valid = found && result.cost == 11 && output.size() == 12 &&
+               output.front() == (Point{0, 0}) && output.back() == (Point{4, 5});
+  bool unreachable = !mapped.FindPath(grid.View(), Point{0, 0}, Point{0, 1}, context, output);
+  // boards of another shape, smaller and larger, than the table
+  Grid smaller(5, 5);
+  Grid larger(6, 6);
+  bool mismatch = !mapped.FindPath(smaller.View(), Point{0, 0}, Point{4, 4}, context, output) &&
+                  output.empty() &&
+                  !mapped.FindPath(larger.View(), Point{0, 0}, Point{5, 5}, context, output, &result) &&
+                  !result.found;
+  if (!loaded) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Save() / Open() round trip lost the landmarks" << "\n";
+    cout << "\n";
+  } else if (!mismatch) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Searched a board of another size with the landmarks" << "\n";
+    cout << "\n";
+  } else if (!admissible || !valid || !unreachable) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Estimate (0,2) -> (0,0): " << estimate(0, 2) << ", true distance: 10" << "\n";
+    cout << "Path length: " << result.cost << ", optimal: 11" << "\n";
+    cout << "Unreachable goal handled: " << unreachable << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestComponentIndex() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "ComponentIndex Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  ComponentIndex<> components(grid.View());
+  bool built = components.Count() == 1 && components.Connected(Point{0, 0}, Point{0, 2}) &&
+               !components.Connected(Point{0, 0}, Point{0, 1}) &&
+               components.ComponentSize(0, 0) == 25;
+
+  // closing the gap under the wall splits the board in two
+  grid(4, 1) = State::kObstacle;
+  components.Update(grid.View(), Point{4, 1});
+  bool split = components.Count() == 2 && !components.Connected(Point{0, 0}, Point{0, 2}) &&
+               components.ComponentSize(0, 0) == 5 && components.ComponentSize(0, 2) == 19;
+  int init[2]{0, 0};
+  int goal[2]{0, 2};
+  SearchContext context;
+  SearchResult result{true, 1, 1};
+  std::cout.setstate(std::ios_base::failbit); // silence "No path found!"
+  Grid output = Search(grid, components, init, goal, context, &result);
+  std::cout.clear();
+  bool rejected = output.Empty() && !result.found && result.expansions == 0;
+
+  // reopening it joins them again
+  grid(4, 1) = State::kEmpty;
+  components.Update(grid.View(), Point{4, 1});
+  vector<Point> path;
+  bool joined = components.Count() == 1 && components.ComponentSize(0, 0) == 25 &&
+                FindPath(grid.View(), components, Point{0, 0}, Point{0, 2}, context, path) &&
+                path.size() == 11;
+  if (!built || !split || !rejected || !joined) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Built: " << built << ", split: " << split << ", rejected: " << rejected
+         << ", joined: " << joined << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestHdaStar() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "HdaStar Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  HdaStar<> search(3);
+  SearchResult result;
+  vector<Point> output;
+  bool found = search.FindPath(grid.View(), Point{0, 0}, Point{4, 5}, output, &result);
+  bool valid = found && result.cost == 11 && output.size() == 12 &&
+               output.front() == (Point{0, 0}) && output.back() == (Point{4, 5});
+  for (std::size_t i = 1; valid && i < output.size(); i++) {
+    int step = std::abs(output[i].x - output[i - 1].x) + std::abs(output[i].y - output[i - 1].y);
+    valid = step == 1 && grid(output[i].x, output[i].y) != State::kObstacle;
+  }
+  bool unreachable = !search.FindPath(grid.View(), Point{0, 0}, Point{0, 1}, output) &&
+                     output.empty();
+  if (!valid || !unreachable) {
+    cout << "failed" << "\n";
+    cout << "\n" << "FindPath({0,0}, {4,5}) = ";
+    for (Point p : output) {
+      cout << "(" << p.x << "," << p.y << ") ";
+    }
+    cout << "\n" << "Path length: " << result.cost << ", optimal: 11" << "\n";
+    cout << "Unreachable goal handled: " << unreachable << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestTiledBoard() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "TiledBoard Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  std::string path = "/tmp/test_tiled_board.tiles";
+  // 2x2 tiles: 3x3 of them, the last row and column padded
+  TiledBoard board;
+  bool opened = WriteTiledBoard(grid.View(), path, 2) && board.Open(path, 2) &&
+                board.Rows() == 5 && board.Cols() == 6;
+  bool same = opened;
+  for (int x = 0; same && x < grid.Rows(); x++) {
+    for (int y = 0; y < grid.Cols(); y++) {
+      same = same && board(x, y) == grid(x, y);
+    }
+  }
+  std::remove(path.c_str());
+
+  board.ResetCounters();
+  TiledSearch<> search;
+  SearchResult result;
+  vector<Point> output;
+  bool found = search.FindPath(board, Point{0, 0}, Point{4, 5}, output, &result);
+  bool valid = found && result.cost == 11 && output.size() == 12 &&
+               output.front() == (Point{0, 0}) && output.back() == (Point{4, 5}) &&
+               search.Tiles() > 0 && search.Tiles() < 9; // it stops before it reaches them all
+  // a cache of 2 tiles can't hold the 8 tiles the search touches
+  bool counted = board.Misses() >= 8 && board.Hits() > board.Misses();
+  bool blocked = !search.FindPath(board, Point{0, 0}, Point{3, 1}, output) && output.empty();
+
+  // 65536 x 65536 cells, more than an int can count: a header and a sparse
+  // payload of empty tiles
+  TiledBoardHeader header{};
+  std::memcpy(header.magic, kTiledBoardMagic, sizeof(header.magic));
+  header.version = kTiledBoardVersion;
+  header.rows = header.cols = 65536;
+  header.tile_size = 256;
+  header.tiles_x = header.tiles_y = 256;
+  header.payload_offset = kTiledBoardPayloadOffset;
+  header.payload_size = std::uint64_t(65536) * 65536;
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(&header),
+                                               sizeof(header));
+  std::filesystem::resize_file(path, header.payload_offset + header.payload_size);
+  TiledBoard huge(path, 4);
+  bool wide = huge.IsOpen() && huge.Size() == std::int64_t(1) << 32 &&
+              huge.Index(65535, 65535) == (std::int64_t(1) << 32) - 1 &&
+              search.FindPath(huge, Point{65530, 65530}, Point{65535, 65535}, output, &result) &&
+              result.cost == 10 && output.back() == (Point{65535, 65535});
+  std::remove(path.c_str());
+  if (!opened || !same) {
+    cout << "failed" << "\n";
+    cout << "\n" << "WriteTiledBoard() / Open() round trip lost cells" << "\n";
+    cout << "\n";
+  } else if (!valid || !counted || !blocked) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Path length: " << result.cost << ", optimal: 11" << "\n";
+    cout << "Hits: " << board.Hits() << ", misses: " << board.Misses() << "\n";
+    cout << "\n";
+  } else if (!wide) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Search on 2^32 cells: path length " << result.cost << ", optimal: 10" << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestSearchStats() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "SearchStats Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchContext context;
+  SearchResult result;
+  vector<Point> output;
+  FindPath(grid.View(), Point{0, 0}, Point{4, 5}, context, output, &result);
+  SearchStats stats = context.Stats();
+  // every expanded cell was pushed once, re-opens only lower keys in place
+  bool counted = stats.expansions == result.expansions && stats.pushes >= stats.expansions &&
+                 stats.peak_open >= 1 && stats.peak_open <= stats.pushes &&
+                 stats.peak_memory >= std::size_t(grid.Size()) * 4 * sizeof(int) &&
+                 stats.total_ms > 0 && stats.neighbor_ms > 0 && stats.open_list_ms > 0;
+  // the next search starts over
+  FindPath(grid.View(), Point{0, 0}, Point{0, 0}, context, output, &result);
+  bool reset = context.Stats().expansions == 1 && context.Stats().pushes == 1 &&
+               context.Stats().reopens == 0;
+  if (!kSearchStats) {
+    // compiled out: nothing is recorded
+    counted = stats.expansions == 0 && stats.pushes == 0 && stats.total_ms == 0;
+    reset = context.Stats().expansions == 0;
+  }
+  if (!counted || !reset) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Expansions: " << stats.expansions << " (search: " << result.expansions
+         << "), pushes: " << stats.pushes << ", re-opens: " << stats.reopens
+         << ", peak open: " << stats.peak_open << ", peak memory: " << stats.peak_memory << "\n";
+    cout << "Times [ms]: neighbors " << stats.neighbor_ms << ", open list "
+         << stats.open_list_ms << ", total " << stats.total_ms << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestNearestGoal() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "FindNearestPath Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  SearchContext context;
+  SearchResult result;
+  vector<Point> output;
+  // (2, 3) is 9 steps away, (0, 2) 10 and (4, 5) 11; the last two are ignored
+  vector<Point> goals{{4, 5}, {0, 2}, {2, 3}, {9, 9}, {0, 1}};
+  bool found = FindNearestPath(grid.View(), Point{0, 0}, goals, context, output, &result);
+  bool nearest = found && result.cost == 9 && output.size() == 10 &&
+                 output.front() == (Point{0, 0}) && output.back() == (Point{2, 3});
+  // only an obstacle and a cell off the board: nothing to reach
+  bool none = !FindNearestPath(grid.View(), Point{0, 0}, vector<Point>{{0, 1}, {5, 0}}, context,
+                               output, &result) && output.empty() && result.expansions == 0;
+  if (!nearest || !none) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Cost: " << result.cost << ", correct: 9, goal reached: ";
+    if (!output.empty()) {
+      cout << "(" << output.back().x << ", " << output.back().y << ")";
+    }
+    cout << ", correct: (2, 3)" << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestFlowField() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "FlowField Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  FlowField<> field(grid.View(), Point{4, 5});
+  vector<Point> output;
+  bool built = field.Distance(0, 0) == 11 && field.Distance(0, 2) == 7 &&
+               field.Follow(Point{0, 0}, output) && output.size() == 12 &&
+               output.back() == (Point{4, 5}) && field.Next(Point{4, 5}) == (Point{4, 5});
+  // (4, 2) is the only way out of the left column
+  grid(4, 2) = State::kObstacle;
+  field.Update(grid.View(), vector<Point>{{4, 2}});
+  bool blocked = !field.Reachable(Point{0, 0}) && !field.Follow(Point{0, 0}, output) &&
+                 output.empty() && field.Distance(0, 2) == 7;
+  grid(4, 2) = State::kEmpty;
+  field.Update(grid.View(), vector<Point>{{4, 2}});
+  bool freed = field.Distance(0, 0) == 11 && field.Follow(Point{0, 0}, output) &&
+               output.size() == 12;
+  if (!built || !blocked || !freed) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Distance from (0, 0): " << field.Distance(0, 0)
+         << ", correct: 11 (unreachable while (4, 2) is blocked)" << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}
+
+void TestCbs() {
+  cout << "----------------------------------------------------------" << "\n";
+  cout << "Cbs Test: ";
+  Grid grid = ReadGridFile("../data/1.board");
+  // one agent leaves the dead end of column 0 while the other goes in: the
+  // second has to step aside into row 3 and wait
+  vector<Query> queries{{Point{0, 0}, Point{4, 3}}, {Point{4, 3}, Point{0, 0}}};
+  vector<vector<Point>> paths;
+  CbsResult result;
+  ConflictBasedSearch<> cbs;
+  bool solved = cbs.Plan(grid.View(), queries, paths, &result) && result.cost == 20 &&
+                paths.size() == 2 && paths[0].front() == (Point{0, 0}) &&
+                paths[0].back() == (Point{4, 3}) && paths[1].back() == (Point{0, 0});
+  bool apart = solved;
+  const std::size_t steps = solved ? std::max(paths[0].size(), paths[1].size()) : 0;
+  for (std::size_t t = 0; t < steps; t++) {
+    auto at = [&](const vector<Point> &path, std::size_t time) {
+      return path[std::min(time, path.size() - 1)];
+    };
+    apart = apart && at(paths[0], t) != at(paths[1], t) &&
+            (t == 0 || at(paths[0], t) != at(paths[1], t - 1) ||
+             at(paths[1], t) != at(paths[0], t - 1));
+  }
+  // two agents can't share a goal
+  queries[1].goal = Point{4, 3};
+  bool shared = !cbs.Plan(grid.View(), queries, paths) && paths.empty();
+  if (!solved || !apart || !shared) {
+    cout << "failed" << "\n";
+    cout << "\n" << "Sum of arrival times: " << result.cost << ", correct: 20" << "\n";
+    cout << "\n";
+  } else {
+    cout << "passed" << "\n";
+  }
+  return;
+}